@@ -0,0 +1,210 @@
+# Usage:
+# cmake -P GenerateKeysymTable.cmake <path/to/xkb_unicode_table.h.in> <path/to/xkb_unicode_table.h>
+
+cmake_minimum_required(VERSION 3.13)
+
+set(template_path "${CMAKE_ARGV3}")
+set(target_path "${CMAKE_ARGV4}")
+
+if (NOT EXISTS "${template_path}")
+    message(FATAL_ERROR "Failed to find template file ${template_path}")
+endif()
+
+# The keysym and UCS pairs of the keysymtab[] table by Markus G. Kuhn, as
+# <keysym>:<ucs> in hexadecimal and sorted by keysym
+set(keysym_pairs
+    01a1:0104 01a2:02d8 01a3:0141 01a5:013d 01a6:015a 01a9:0160 01aa:015e 01ab:0164
+    01ac:0179 01ae:017d 01af:017b 01b1:0105 01b2:02db 01b3:0142 01b5:013e 01b6:015b
+    01b7:02c7 01b9:0161 01ba:015f 01bb:0165 01bc:017a 01bd:02dd 01be:017e 01bf:017c
+    01c0:0154 01c3:0102 01c5:0139 01c6:0106 01c8:010c 01ca:0118 01cc:011a 01cf:010e
+    01d0:0110 01d1:0143 01d2:0147 01d5:0150 01d8:0158 01d9:016e 01db:0170 01de:0162
+    01e0:0155 01e3:0103 01e5:013a 01e6:0107 01e8:010d 01ea:0119 01ec:011b 01ef:010f
+    01f0:0111 01f1:0144 01f2:0148 01f5:0151 01f8:0159 01f9:016f 01fb:0171 01fe:0163
+    01ff:02d9 02a1:0126 02a6:0124 02a9:0130 02ab:011e 02ac:0134 02b1:0127 02b6:0125
+    02b9:0131 02bb:011f 02bc:0135 02c5:010a 02c6:0108 02d5:0120 02d8:011c 02dd:016c
+    02de:015c 02e5:010b 02e6:0109 02f5:0121 02f8:011d 02fd:016d 02fe:015d 03a2:0138
+    03a3:0156 03a5:0128 03a6:013b 03aa:0112 03ab:0122 03ac:0166 03b3:0157 03b5:0129
+    03b6:013c 03ba:0113 03bb:0123 03bc:0167 03bd:014a 03bf:014b 03c0:0100 03c7:012e
+    03cc:0116 03cf:012a 03d1:0145 03d2:014c 03d3:0136 03d9:0172 03dd:0168 03de:016a
+    03e0:0101 03e7:012f 03ec:0117 03ef:012b 03f1:0146 03f2:014d 03f3:0137 03f9:0173
+    03fd:0169 03fe:016b 047e:203e 04a1:3002 04a2:300c 04a3:300d 04a4:3001 04a5:30fb
+    04a6:30f2 04a7:30a1 04a8:30a3 04a9:30a5 04aa:30a7 04ab:30a9 04ac:30e3 04ad:30e5
+    04ae:30e7 04af:30c3 04b0:30fc 04b1:30a2 04b2:30a4 04b3:30a6 04b4:30a8 04b5:30aa
+    04b6:30ab 04b7:30ad 04b8:30af 04b9:30b1 04ba:30b3 04bb:30b5 04bc:30b7 04bd:30b9
+    04be:30bb 04bf:30bd 04c0:30bf 04c1:30c1 04c2:30c4 04c3:30c6 04c4:30c8 04c5:30ca
+    04c6:30cb 04c7:30cc 04c8:30cd 04c9:30ce 04ca:30cf 04cb:30d2 04cc:30d5 04cd:30d8
+    04ce:30db 04cf:30de 04d0:30df 04d1:30e0 04d2:30e1 04d3:30e2 04d4:30e4 04d5:30e6
+    04d6:30e8 04d7:30e9 04d8:30ea 04d9:30eb 04da:30ec 04db:30ed 04dc:30ef 04dd:30f3
+    04de:309b 04df:309c 05ac:060c 05bb:061b 05bf:061f 05c1:0621 05c2:0622 05c3:0623
+    05c4:0624 05c5:0625 05c6:0626 05c7:0627 05c8:0628 05c9:0629 05ca:062a 05cb:062b
+    05cc:062c 05cd:062d 05ce:062e 05cf:062f 05d0:0630 05d1:0631 05d2:0632 05d3:0633
+    05d4:0634 05d5:0635 05d6:0636 05d7:0637 05d8:0638 05d9:0639 05da:063a 05e0:0640
+    05e1:0641 05e2:0642 05e3:0643 05e4:0644 05e5:0645 05e6:0646 05e7:0647 05e8:0648
+    05e9:0649 05ea:064a 05eb:064b 05ec:064c 05ed:064d 05ee:064e 05ef:064f 05f0:0650
+    05f1:0651 05f2:0652 06a1:0452 06a2:0453 06a3:0451 06a4:0454 06a5:0455 06a6:0456
+    06a7:0457 06a8:0458 06a9:0459 06aa:045a 06ab:045b 06ac:045c 06ae:045e 06af:045f
+    06b0:2116 06b1:0402 06b2:0403 06b3:0401 06b4:0404 06b5:0405 06b6:0406 06b7:0407
+    06b8:0408 06b9:0409 06ba:040a 06bb:040b 06bc:040c 06be:040e 06bf:040f 06c0:044e
+    06c1:0430 06c2:0431 06c3:0446 06c4:0434 06c5:0435 06c6:0444 06c7:0433 06c8:0445
+    06c9:0438 06ca:0439 06cb:043a 06cc:043b 06cd:043c 06ce:043d 06cf:043e 06d0:043f
+    06d1:044f 06d2:0440 06d3:0441 06d4:0442 06d5:0443 06d6:0436 06d7:0432 06d8:044c
+    06d9:044b 06da:0437 06db:0448 06dc:044d 06dd:0449 06de:0447 06df:044a 06e0:042e
+    06e1:0410 06e2:0411 06e3:0426 06e4:0414 06e5:0415 06e6:0424 06e7:0413 06e8:0425
+    06e9:0418 06ea:0419 06eb:041a 06ec:041b 06ed:041c 06ee:041d 06ef:041e 06f0:041f
+    06f1:042f 06f2:0420 06f3:0421 06f4:0422 06f5:0423 06f6:0416 06f7:0412 06f8:042c
+    06f9:042b 06fa:0417 06fb:0428 06fc:042d 06fd:0429 06fe:0427 06ff:042a 07a1:0386
+    07a2:0388 07a3:0389 07a4:038a 07a5:03aa 07a7:038c 07a8:038e 07a9:03ab 07ab:038f
+    07ae:0385 07af:2015 07b1:03ac 07b2:03ad 07b3:03ae 07b4:03af 07b5:03ca 07b6:0390
+    07b7:03cc 07b8:03cd 07b9:03cb 07ba:03b0 07bb:03ce 07c1:0391 07c2:0392 07c3:0393
+    07c4:0394 07c5:0395 07c6:0396 07c7:0397 07c8:0398 07c9:0399 07ca:039a 07cb:039b
+    07cc:039c 07cd:039d 07ce:039e 07cf:039f 07d0:03a0 07d1:03a1 07d2:03a3 07d4:03a4
+    07d5:03a5 07d6:03a6 07d7:03a7 07d8:03a8 07d9:03a9 07e1:03b1 07e2:03b2 07e3:03b3
+    07e4:03b4 07e5:03b5 07e6:03b6 07e7:03b7 07e8:03b8 07e9:03b9 07ea:03ba 07eb:03bb
+    07ec:03bc 07ed:03bd 07ee:03be 07ef:03bf 07f0:03c0 07f1:03c1 07f2:03c3 07f3:03c2
+    07f4:03c4 07f5:03c5 07f6:03c6 07f7:03c7 07f8:03c8 07f9:03c9 08a1:23b7 08a2:250c
+    08a3:2500 08a4:2320 08a5:2321 08a6:2502 08a7:23a1 08a8:23a3 08a9:23a4 08aa:23a6
+    08ab:239b 08ac:239d 08ad:239e 08ae:23a0 08af:23a8 08b0:23ac 08bc:2264 08bd:2260
+    08be:2265 08bf:222b 08c0:2234 08c1:221d 08c2:221e 08c5:2207 08c8:223c 08c9:2243
+    08cd:21d4 08ce:21d2 08cf:2261 08d6:221a 08da:2282 08db:2283 08dc:2229 08dd:222a
+    08de:2227 08df:2228 08ef:2202 08f6:0192 08fb:2190 08fc:2191 08fd:2192 08fe:2193
+    09e0:25c6 09e1:2592 09e2:2409 09e3:240c 09e4:240d 09e5:240a 09e8:2424 09e9:240b
+    09ea:2518 09eb:2510 09ec:250c 09ed:2514 09ee:253c 09ef:23ba 09f0:23bb 09f1:2500
+    09f2:23bc 09f3:23bd 09f4:251c 09f5:2524 09f6:2534 09f7:252c 09f8:2502 0aa1:2003
+    0aa2:2002 0aa3:2004 0aa4:2005 0aa5:2007 0aa6:2008 0aa7:2009 0aa8:200a 0aa9:2014
+    0aaa:2013 0aae:2026 0aaf:2025 0ab0:2153 0ab1:2154 0ab2:2155 0ab3:2156 0ab4:2157
+    0ab5:2158 0ab6:2159 0ab7:215a 0ab8:2105 0abb:2012 0abc:2329 0abe:232a 0ac3:215b
+    0ac4:215c 0ac5:215d 0ac6:215e 0ac9:2122 0aca:2613 0acc:25c1 0acd:25b7 0ace:25cb
+    0acf:25af 0ad0:2018 0ad1:2019 0ad2:201c 0ad3:201d 0ad4:211e 0ad6:2032 0ad7:2033
+    0ad9:271d 0adb:25ac 0adc:25c0 0add:25b6 0ade:25cf 0adf:25ae 0ae0:25e6 0ae1:25ab
+    0ae2:25ad 0ae3:25b3 0ae4:25bd 0ae5:2606 0ae6:2022 0ae7:25aa 0ae8:25b2 0ae9:25bc
+    0aea:261c 0aeb:261e 0aec:2663 0aed:2666 0aee:2665 0af0:2720 0af1:2020 0af2:2021
+    0af3:2713 0af4:2717 0af5:266f 0af6:266d 0af7:2642 0af8:2640 0af9:260e 0afa:2315
+    0afb:2117 0afc:2038 0afd:201a 0afe:201e 0ba3:003c 0ba6:003e 0ba8:2228 0ba9:2227
+    0bc0:00af 0bc2:22a5 0bc3:2229 0bc4:230a 0bc6:005f 0bca:2218 0bcc:2395 0bce:22a4
+    0bcf:25cb 0bd3:2308 0bd6:222a 0bd8:2283 0bda:2282 0bdc:22a2 0bfc:22a3 0cdf:2017
+    0ce0:05d0 0ce1:05d1 0ce2:05d2 0ce3:05d3 0ce4:05d4 0ce5:05d5 0ce6:05d6 0ce7:05d7
+    0ce8:05d8 0ce9:05d9 0cea:05da 0ceb:05db 0cec:05dc 0ced:05dd 0cee:05de 0cef:05df
+    0cf0:05e0 0cf1:05e1 0cf2:05e2 0cf3:05e3 0cf4:05e4 0cf5:05e5 0cf6:05e6 0cf7:05e7
+    0cf8:05e8 0cf9:05e9 0cfa:05ea 0da1:0e01 0da2:0e02 0da3:0e03 0da4:0e04 0da5:0e05
+    0da6:0e06 0da7:0e07 0da8:0e08 0da9:0e09 0daa:0e0a 0dab:0e0b 0dac:0e0c 0dad:0e0d
+    0dae:0e0e 0daf:0e0f 0db0:0e10 0db1:0e11 0db2:0e12 0db3:0e13 0db4:0e14 0db5:0e15
+    0db6:0e16 0db7:0e17 0db8:0e18 0db9:0e19 0dba:0e1a 0dbb:0e1b 0dbc:0e1c 0dbd:0e1d
+    0dbe:0e1e 0dbf:0e1f 0dc0:0e20 0dc1:0e21 0dc2:0e22 0dc3:0e23 0dc4:0e24 0dc5:0e25
+    0dc6:0e26 0dc7:0e27 0dc8:0e28 0dc9:0e29 0dca:0e2a 0dcb:0e2b 0dcc:0e2c 0dcd:0e2d
+    0dce:0e2e 0dcf:0e2f 0dd0:0e30 0dd1:0e31 0dd2:0e32 0dd3:0e33 0dd4:0e34 0dd5:0e35
+    0dd6:0e36 0dd7:0e37 0dd8:0e38 0dd9:0e39 0dda:0e3a 0ddf:0e3f 0de0:0e40 0de1:0e41
+    0de2:0e42 0de3:0e43 0de4:0e44 0de5:0e45 0de6:0e46 0de7:0e47 0de8:0e48 0de9:0e49
+    0dea:0e4a 0deb:0e4b 0dec:0e4c 0ded:0e4d 0df0:0e50 0df1:0e51 0df2:0e52 0df3:0e53
+    0df4:0e54 0df5:0e55 0df6:0e56 0df7:0e57 0df8:0e58 0df9:0e59 0ea1:3131 0ea2:3132
+    0ea3:3133 0ea4:3134 0ea5:3135 0ea6:3136 0ea7:3137 0ea8:3138 0ea9:3139 0eaa:313a
+    0eab:313b 0eac:313c 0ead:313d 0eae:313e 0eaf:313f 0eb0:3140 0eb1:3141 0eb2:3142
+    0eb3:3143 0eb4:3144 0eb5:3145 0eb6:3146 0eb7:3147 0eb8:3148 0eb9:3149 0eba:314a
+    0ebb:314b 0ebc:314c 0ebd:314d 0ebe:314e 0ebf:314f 0ec0:3150 0ec1:3151 0ec2:3152
+    0ec3:3153 0ec4:3154 0ec5:3155 0ec6:3156 0ec7:3157 0ec8:3158 0ec9:3159 0eca:315a
+    0ecb:315b 0ecc:315c 0ecd:315d 0ece:315e 0ecf:315f 0ed0:3160 0ed1:3161 0ed2:3162
+    0ed3:3163 0ed4:11a8 0ed5:11a9 0ed6:11aa 0ed7:11ab 0ed8:11ac 0ed9:11ad 0eda:11ae
+    0edb:11af 0edc:11b0 0edd:11b1 0ede:11b2 0edf:11b3 0ee0:11b4 0ee1:11b5 0ee2:11b6
+    0ee3:11b7 0ee4:11b8 0ee5:11b9 0ee6:11ba 0ee7:11bb 0ee8:11bc 0ee9:11bd 0eea:11be
+    0eeb:11bf 0eec:11c0 0eed:11c1 0eee:11c2 0eef:316d 0ef0:3171 0ef1:3178 0ef2:317f
+    0ef3:3181 0ef4:3184 0ef5:3186 0ef6:318d 0ef7:318e 0ef8:11eb 0ef9:11f0 0efa:11f9
+    0eff:20a9 13a4:20ac 13bc:0152 13bd:0153 13be:0178 20ac:20ac fe50:0060 fe51:00b4
+    fe52:005e fe53:007e fe54:00af fe55:02d8 fe56:02d9 fe57:00a8 fe58:02da fe59:02dd
+    fe5a:02c7 fe5b:00b8 fe5c:02db fe5d:037a fe5e:309b fe5f:309c fe63:002f fe64:02bc
+    fe65:02bd fe66:02f5 fe67:02f3 fe68:02cd fe69:a788 fe6a:02f7 fe6e:002c fe6f:00a4
+    fe80:0061 fe81:0041 fe82:0065 fe83:0045 fe84:0069 fe85:0049 fe86:006f fe87:004f
+    fe88:0075 fe89:0055 fe8a:0259 fe8b:018f fe8c:00b5 fe90:005f fe91:02c8 fe92:02cc
+    ff80:0020 ff95:0037 ff96:0034 ff97:0038 ff98:0036 ff99:0032 ff9a:0039 ff9b:0033
+    ff9c:0031 ff9d:0035 ff9e:0030 ffaa:002a ffab:002b ffac:002c ffad:002d ffae:002e
+    ffaf:002f ffb0:0030 ffb1:0031 ffb2:0032 ffb3:0033 ffb4:0034 ffb5:0035 ffb6:0036
+    ffb7:0037 ffb8:0038 ffb9:0039 ffbd:003d
+)
+
+# Each group of 32 keysyms with any mapped keysym gets its own block
+foreach(pair ${keysym_pairs})
+    string(REPLACE ":" ";" pair "${pair}")
+    list(GET pair 0 keysym)
+    list(GET pair 1 ucs)
+    math(EXPR group "0x${keysym} >> 5")
+    math(EXPR slot "0x${keysym} & 31")
+    set(group_${group} TRUE)
+    set(value_${group}_${slot} "0x${ucs}")
+endforeach()
+
+# Block zero is all zero and shared by every group without mapped keysyms
+set(block_count 1)
+set(GLFW_KEYSYM_VALUES "    { // no mapping\n")
+foreach(row RANGE 3)
+    set(GLFW_KEYSYM_VALUES "${GLFW_KEYSYM_VALUES}        0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000")
+    if (row LESS 3)
+        set(GLFW_KEYSYM_VALUES "${GLFW_KEYSYM_VALUES},")
+    endif()
+    set(GLFW_KEYSYM_VALUES "${GLFW_KEYSYM_VALUES}\n")
+endforeach()
+set(GLFW_KEYSYM_VALUES "${GLFW_KEYSYM_VALUES}    }")
+
+set(GLFW_KEYSYM_BLOCKS "")
+foreach(group RANGE 2047)
+    if (group_${group})
+        set(block ${block_count})
+        math(EXPR block_count "${block_count} + 1")
+
+        math(EXPR first "${group} << 5" OUTPUT_FORMAT HEXADECIMAL)
+        math(EXPR last "(${group} << 5) + 31" OUTPUT_FORMAT HEXADECIMAL)
+        string(REPLACE "0x" "" first "${first}")
+        string(REPLACE "0x" "" last "${last}")
+        string(LENGTH "${first}" length)
+        while (length LESS 4)
+            set(first "0${first}")
+            set(last "0${last}")
+            string(LENGTH "${first}" length)
+        endwhile()
+
+        set(GLFW_KEYSYM_VALUES "${GLFW_KEYSYM_VALUES},\n    { // keysyms 0x${first} to 0x${last}\n        ")
+        foreach(slot RANGE 31)
+            if (DEFINED value_${group}_${slot})
+                set(GLFW_KEYSYM_VALUES "${GLFW_KEYSYM_VALUES}${value_${group}_${slot}}")
+            else()
+                set(GLFW_KEYSYM_VALUES "${GLFW_KEYSYM_VALUES}0x0000")
+            endif()
+
+            if (slot EQUAL 31)
+                set(GLFW_KEYSYM_VALUES "${GLFW_KEYSYM_VALUES}\n    }")
+            else()
+                math(EXPR column "${slot} % 8")
+                if (column EQUAL 7)
+                    set(GLFW_KEYSYM_VALUES "${GLFW_KEYSYM_VALUES},\n        ")
+                else()
+                    set(GLFW_KEYSYM_VALUES "${GLFW_KEYSYM_VALUES}, ")
+                endif()
+            endif()
+        endforeach()
+    else()
+        set(block 0)
+    endif()
+
+    # Sixteen right-aligned block indices per line
+    math(EXPR column "${group} % 16")
+    if (column EQUAL 0)
+        set(GLFW_KEYSYM_BLOCKS "${GLFW_KEYSYM_BLOCKS}    ")
+    else()
+        set(GLFW_KEYSYM_BLOCKS "${GLFW_KEYSYM_BLOCKS} ")
+    endif()
+    if (block LESS 10)
+        set(GLFW_KEYSYM_BLOCKS "${GLFW_KEYSYM_BLOCKS} ")
+    endif()
+    set(GLFW_KEYSYM_BLOCKS "${GLFW_KEYSYM_BLOCKS}${block}")
+    if (group LESS 2047)
+        set(GLFW_KEYSYM_BLOCKS "${GLFW_KEYSYM_BLOCKS},")
+        if (column EQUAL 15)
+            set(GLFW_KEYSYM_BLOCKS "${GLFW_KEYSYM_BLOCKS}\n")
+        endif()
+    endif()
+endforeach()
+
+if (block_count GREATER 256)
+    message(FATAL_ERROR "Too many keysym blocks for the unsigned char index")
+endif()
+
+set(GLFW_KEYSYM_BLOCK_COUNT ${block_count})
+
+configure_file("${template_path}" "${target_path}" @ONLY NEWLINE_STYLE UNIX)
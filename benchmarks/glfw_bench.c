@@ -0,0 +1,598 @@
+//========================================================================
+// Microbenchmarks of GLFW hot paths
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This program times a set of operations that applications perform often or
+// that are on the critical path of startup, and writes the results as JSON
+// so they can be compared between releases
+//
+// It needs no user interaction and is meant to be run headless, either with
+// a library built for the null platform (GLFW_USE_OSMESA), under Xvfb or
+// under a Wayland compositor with a headless backend.  On the null platform
+// the event flood is made of injected input events, elsewhere it is made of
+// empty events.
+//
+// Each benchmark runs a number of rounds of a fixed number of operations and
+// reports the minimum, median, mean and maximum time per operation across the
+// rounds.  Benchmarks that cannot run on the current platform, for example
+// because no OpenGL context could be created, are reported as skipped.
+//
+//========================================================================
+
+#if defined(_WIN32)
+ #include <windows.h>
+#else
+ #include <time.h>
+#endif
+
+#include <GLFW/glfw3.h>
+#if defined(GLFW_EXPOSE_NATIVE_NULL)
+ #include <GLFW/glfw3native.h>
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "getopt.h"
+
+// The gamepad mapping database used by the library, renamed to not clash
+// with the copy in the library itself
+#define _glfwDefaultMappings defaultMappings
+#include "mappings.h"
+#undef _glfwDefaultMappings
+
+// The keysym translation of the library, built into this program from source
+#include "xkb_unicode.h"
+
+#define EVENT_FLOOD_SIZE 64
+// The mapping array is terminated by NULL
+#define MAPPING_COUNT (sizeof(defaultMappings) / sizeof(defaultMappings[0]) - 1)
+// The keysyms covered by the translation table
+#define KEYSYM_COUNT 0x10000
+
+typedef struct Benchmark
+{
+    const char* name;
+    // The number of operations per round
+    int iterations;
+    // The number of items each operation processes, e.g. events or mappings
+    int items;
+    // Whether the library is initialized while the benchmark runs
+    int initialized;
+    // Returns NULL on success or the reason the benchmark cannot run
+    const char* (*setup)(void);
+    void (*run)(int iterations);
+    void (*cleanup)(void);
+} Benchmark;
+
+static GLFWwindow* window = NULL;
+static char* mappings = NULL;
+static unsigned short* keysymPairs = NULL;
+static int keysymPairCount = 0;
+static volatile double sink = 0.0;
+
+static double get_seconds(void)
+{
+#if defined(_WIN32)
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double) counter.QuadPart / (double) frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+#endif
+}
+
+static const char* create_hidden_window(int client_api)
+{
+    glfwDefaultWindowHints();
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CLIENT_API, client_api);
+
+    window = glfwCreateWindow(640, 480, "GLFW Benchmark", NULL, NULL);
+    if (!window)
+        return "window creation failed";
+
+    return NULL;
+}
+
+static const char* setup_window(void)
+{
+    return create_hidden_window(GLFW_NO_API);
+}
+
+static const char* setup_context(void)
+{
+    if (create_hidden_window(GLFW_OPENGL_API))
+        return "OpenGL context creation failed";
+
+    glfwMakeContextCurrent(window);
+    return NULL;
+}
+
+static void destroy_window(void)
+{
+    glfwDestroyWindow(window);
+    window = NULL;
+}
+
+static const char* setup_mappings(void)
+{
+    size_t i, size = 1;
+
+    for (i = 0;  i < MAPPING_COUNT;  i++)
+        size += strlen(defaultMappings[i]) + 1;
+
+    mappings = calloc(size, 1);
+    if (!mappings)
+        return "out of memory";
+
+    for (i = 0;  i < MAPPING_COUNT;  i++)
+    {
+        strcat(mappings, defaultMappings[i]);
+        strcat(mappings, "\n");
+    }
+
+    return NULL;
+}
+
+static void free_mappings(void)
+{
+    free(mappings);
+    mappings = NULL;
+}
+
+// Builds the sorted keysym and UCS pairs searched by the previous keysym
+// translation, from the table of the current one
+static const char* setup_keysym_pairs(void)
+{
+    unsigned int keysym;
+
+    keysymPairs = calloc(KEYSYM_COUNT, 2 * sizeof(unsigned short));
+    if (!keysymPairs)
+        return "out of memory";
+
+    for (keysym = 0;  keysym < KEYSYM_COUNT;  keysym++)
+    {
+        long ucs;
+
+        // Latin-1 keysyms are handled before the search
+        if ((keysym >= 0x0020 && keysym <= 0x007e) ||
+            (keysym >= 0x00a0 && keysym <= 0x00ff))
+        {
+            continue;
+        }
+
+        ucs = _glfwKeySym2Unicode(keysym);
+        if (ucs != -1)
+        {
+            keysymPairs[keysymPairCount * 2 + 0] = (unsigned short) keysym;
+            keysymPairs[keysymPairCount * 2 + 1] = (unsigned short) ucs;
+            keysymPairCount++;
+        }
+    }
+
+    return NULL;
+}
+
+static void free_keysym_pairs(void)
+{
+    free(keysymPairs);
+    keysymPairs = NULL;
+    keysymPairCount = 0;
+}
+
+// The binary search of _glfwKeySym2Unicode before the two-level table
+static long searchKeySym2Unicode(unsigned int keysym)
+{
+    int min = 0;
+    int max = keysymPairCount - 1;
+    int mid;
+
+    if ((keysym >= 0x0020 && keysym <= 0x007e) ||
+        (keysym >= 0x00a0 && keysym <= 0x00ff))
+    {
+        return keysym;
+    }
+
+    if ((keysym & 0xff000000) == 0x01000000)
+        return keysym & 0x00ffffff;
+
+    while (max >= min)
+    {
+        mid = (min + max) / 2;
+        if (keysymPairs[mid * 2] < keysym)
+            min = mid + 1;
+        else if (keysymPairs[mid * 2] > keysym)
+            max = mid - 1;
+        else
+            return keysymPairs[mid * 2 + 1];
+    }
+
+    return -1;
+}
+
+static void run_init_terminate(int iterations)
+{
+    int i;
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        if (!glfwInit())
+            exit(EXIT_FAILURE);
+
+        glfwTerminate();
+    }
+}
+
+static void run_window_create_destroy(int iterations)
+{
+    int i;
+
+    glfwDefaultWindowHints();
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        GLFWwindow* handle = glfwCreateWindow(640, 480, "", NULL, NULL);
+        if (!handle)
+            exit(EXIT_FAILURE);
+
+        glfwDestroyWindow(handle);
+    }
+}
+
+static void run_poll_events_idle(int iterations)
+{
+    int i;
+
+    for (i = 0;  i < iterations;  i++)
+        glfwPollEvents();
+}
+
+static void run_poll_events_flood(int iterations)
+{
+    int i, j;
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        for (j = 0;  j < EVENT_FLOOD_SIZE;  j += 2)
+        {
+#if defined(GLFW_EXPOSE_NATIVE_NULL)
+            glfwNullInjectCursorPos(window, j, i);
+            glfwNullInjectKey(window, GLFW_KEY_A, -1,
+                              (j & 2) ? GLFW_RELEASE : GLFW_PRESS, 0);
+#else
+            glfwPostEmptyEvent();
+            glfwPostEmptyEvent();
+#endif
+        }
+
+        glfwPollEvents();
+    }
+}
+
+static void run_update_gamepad_mappings(int iterations)
+{
+    int i;
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        if (!glfwUpdateGamepadMappings(mappings))
+            exit(EXIT_FAILURE);
+    }
+}
+
+static void run_get_gamepad_state(int iterations)
+{
+    int i;
+    GLFWgamepadstate state;
+
+    for (i = 0;  i < iterations;  i++)
+        sink += glfwGetGamepadState(i & GLFW_JOYSTICK_LAST, &state);
+}
+
+static void run_extension_supported(int iterations)
+{
+    int i;
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        sink += glfwExtensionSupported("GL_ARB_multisample");
+        sink += glfwExtensionSupported("GL_GLFW_missing_extension");
+    }
+}
+
+static void run_get_proc_address(int iterations)
+{
+    int i;
+
+    for (i = 0;  i < iterations;  i++)
+        sink += glfwGetProcAddress("glClear") != NULL;
+}
+
+static void run_keysym_to_unicode(int iterations)
+{
+    int i;
+    unsigned int keysym;
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        long sum = 0;
+
+        for (keysym = 0;  keysym < KEYSYM_COUNT;  keysym++)
+            sum += _glfwKeySym2Unicode(keysym);
+
+        sink += (double) sum;
+    }
+}
+
+static void run_keysym_to_unicode_search(int iterations)
+{
+    int i;
+    unsigned int keysym;
+
+    for (i = 0;  i < iterations;  i++)
+    {
+        long sum = 0;
+
+        for (keysym = 0;  keysym < KEYSYM_COUNT;  keysym++)
+            sum += searchKeySym2Unicode(keysym);
+
+        sink += (double) sum;
+    }
+}
+
+static void run_get_time(int iterations)
+{
+    int i;
+
+    for (i = 0;  i < iterations;  i++)
+        sink += glfwGetTime();
+}
+
+static void run_get_timer_value(int iterations)
+{
+    int i;
+
+    for (i = 0;  i < iterations;  i++)
+        sink += (double) glfwGetTimerValue();
+}
+
+static const Benchmark benchmarks[] =
+{
+    { "init_terminate", 20, 1, 0, NULL, run_init_terminate, NULL },
+    { "window_create_destroy", 50, 1, 1, NULL, run_window_create_destroy, NULL },
+    { "poll_events_idle", 10000, 1, 1, setup_window, run_poll_events_idle, destroy_window },
+    { "poll_events_flood", 1000, EVENT_FLOOD_SIZE, 1, setup_window, run_poll_events_flood, destroy_window },
+    { "update_gamepad_mappings", 10, MAPPING_COUNT, 1, setup_mappings, run_update_gamepad_mappings, free_mappings },
+    { "get_gamepad_state", 100000, 1, 1, NULL, run_get_gamepad_state, NULL },
+    { "extension_supported", 10000, 2, 1, setup_context, run_extension_supported, destroy_window },
+    { "get_proc_address", 100000, 1, 1, setup_context, run_get_proc_address, destroy_window },
+    { "keysym_to_unicode", 10, KEYSYM_COUNT, 0, NULL, run_keysym_to_unicode, NULL },
+    { "keysym_to_unicode_search", 10, KEYSYM_COUNT, 0, setup_keysym_pairs, run_keysym_to_unicode_search, free_keysym_pairs },
+    { "get_time", 1000000, 1, 1, NULL, run_get_time, NULL },
+    { "get_timer_value", 1000000, 1, 1, NULL, run_get_timer_value, NULL }
+};
+
+#define BENCHMARK_COUNT (sizeof(benchmarks) / sizeof(benchmarks[0]))
+
+static void usage(void)
+{
+    printf("Usage: glfw_bench [-h] [-l] [-f FILTER] [-o FILE] [-r ROUNDS] [-s SCALE]\n");
+    printf("Options:\n");
+    printf("  -f, run only benchmarks whose name contains FILTER\n");
+    printf("  -h, show this help\n");
+    printf("  -l, list the benchmarks and exit\n");
+    printf("  -o, write the results to FILE instead of standard output\n");
+    printf("  -r, run each benchmark ROUNDS times (default 10)\n");
+    printf("  -s, multiply the iteration counts by SCALE (default 1.0)\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void write_json_string(FILE* file, const char* string)
+{
+    fputc('"', file);
+
+    for (;  *string;  string++)
+    {
+        const unsigned char c = (unsigned char) *string;
+
+        if (c == '"' || c == '\\')
+            fprintf(file, "\\%c", c);
+        else if (c < 0x20)
+            fprintf(file, "\\u%04x", c);
+        else
+            fputc(c, file);
+    }
+
+    fputc('"', file);
+}
+
+static int compare_doubles(const void* fp, const void* sp)
+{
+    const double f = *(const double*) fp;
+    const double s = *(const double*) sp;
+    return (f > s) - (f < s);
+}
+
+// Runs the specified benchmark and writes its result as a JSON object
+//
+static void run_benchmark(FILE* file,
+                          const Benchmark* benchmark,
+                          int rounds,
+                          double scale)
+{
+    int round, iterations;
+    double* times;
+    double sum = 0.0;
+    const char* reason = NULL;
+
+    iterations = (int) (benchmark->iterations * scale);
+    if (iterations < 1)
+        iterations = 1;
+
+    if (benchmark->initialized && !glfwInit())
+        exit(EXIT_FAILURE);
+
+    if (benchmark->setup)
+        reason = benchmark->setup();
+
+    fprintf(file, "    {\n      \"name\": ");
+    write_json_string(file, benchmark->name);
+
+    if (reason)
+    {
+        fprintf(file, ",\n      \"status\": \"skipped\",\n      \"reason\": ");
+        write_json_string(file, reason);
+        fprintf(file, "\n    }");
+
+        if (benchmark->initialized)
+            glfwTerminate();
+
+        return;
+    }
+
+    times = calloc(rounds, sizeof(double));
+
+    for (round = 0;  round < rounds;  round++)
+    {
+        const double start = get_seconds();
+        benchmark->run(iterations);
+        times[round] = (get_seconds() - start) * 1e9 / iterations;
+        sum += times[round];
+    }
+
+    if (benchmark->cleanup)
+        benchmark->cleanup();
+
+    if (benchmark->initialized)
+        glfwTerminate();
+
+    qsort(times, rounds, sizeof(double), compare_doubles);
+
+    fprintf(file, ",\n      \"status\": \"ok\",\n");
+    fprintf(file, "      \"rounds\": %i,\n", rounds);
+    fprintf(file, "      \"iterations\": %i,\n", iterations);
+    fprintf(file, "      \"items_per_op\": %i,\n", benchmark->items);
+    fprintf(file, "      \"min_ns\": %.3f,\n", times[0]);
+    fprintf(file, "      \"median_ns\": %.3f,\n", times[rounds / 2]);
+    fprintf(file, "      \"mean_ns\": %.3f,\n", sum / rounds);
+    fprintf(file, "      \"max_ns\": %.3f\n", times[rounds - 1]);
+    fprintf(file, "    }");
+
+    free(times);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, rounds = 10, first = 1;
+    size_t i;
+    double scale = 1.0;
+    const char* filter = NULL;
+    FILE* file = stdout;
+
+    while ((ch = getopt(argc, argv, "f:hlo:r:s:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'f':
+                filter = optarg;
+                break;
+
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'l':
+                for (i = 0;  i < BENCHMARK_COUNT;  i++)
+                    printf("%s\n", benchmarks[i].name);
+                exit(EXIT_SUCCESS);
+
+            case 'o':
+                file = fopen(optarg, "w");
+                if (!file)
+                {
+                    fprintf(stderr, "Failed to open %s\n", optarg);
+                    exit(EXIT_FAILURE);
+                }
+                break;
+
+            case 'r':
+                rounds = atoi(optarg);
+                if (rounds < 1)
+                {
+                    usage();
+                    exit(EXIT_FAILURE);
+                }
+                break;
+
+            case 's':
+                scale = atof(optarg);
+                if (scale <= 0.0)
+                {
+                    usage();
+                    exit(EXIT_FAILURE);
+                }
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    fprintf(file, "{\n  \"version\": ");
+    write_json_string(file, glfwGetVersionString());
+    fprintf(file, ",\n  \"benchmarks\": [\n");
+
+    for (i = 0;  i < BENCHMARK_COUNT;  i++)
+    {
+        if (filter && !strstr(benchmarks[i].name, filter))
+            continue;
+
+        if (!first)
+            fprintf(file, ",\n");
+
+        run_benchmark(file, benchmarks + i, rounds, scale);
+        first = 0;
+    }
+
+    fprintf(file, "\n  ]\n}\n");
+
+    if (file != stdout)
+        fclose(file);
+
+    exit(EXIT_SUCCESS);
+}
@@ -1066,6 +1066,21 @@ extern "C" {
  *  Joystick hat buttons [init hint](@ref GLFW_JOYSTICK_HAT_BUTTONS)
  */
 #define GLFW_JOYSTICK_HAT_BUTTONS   0x00050001
+/*! @brief Virtual clock init hint.
+ *
+ *  Virtual clock [init hint](@ref GLFW_VIRTUAL_CLOCK).
+ */
+#define GLFW_VIRTUAL_CLOCK          0x00050002
+/*! @brief TSC timer init hint.
+ *
+ *  TSC timer [init hint](@ref GLFW_TSC_TIMER).
+ */
+#define GLFW_TSC_TIMER              0x00050003
+/*! @brief Vulkan cache init hint.
+ *
+ *  Vulkan cache [init hint](@ref GLFW_VULKAN_CACHE).
+ */
+#define GLFW_VULKAN_CACHE           0x00050004
 /*! @brief macOS specific init hint.
  *
  *  macOS specific [init hint](@ref GLFW_COCOA_CHDIR_RESOURCES)
@@ -1076,6 +1091,29 @@ extern "C" {
  *  macOS specific [init hint](@ref GLFW_COCOA_MENUBAR)
  */
 #define GLFW_COCOA_MENUBAR          0x00051002
+/*! @brief X11 specific init hint.
+ *
+ *  X11 specific [init hint](@ref GLFW_X11_ASYNC_WINDOWS).
+ */
+#define GLFW_X11_ASYNC_WINDOWS      0x00052001
+/*! @} */
+
+/*! @addtogroup input
+ *  @{ */
+/*! @brief Real time input replay.
+ *
+ *  Replayed events are delivered at the times they were recorded.
+ *
+ *  @sa @ref glfwStartReplay
+ */
+#define GLFW_REPLAY_REALTIME        0x00060001
+/*! @brief Fast input replay.
+ *
+ *  Replayed events are delivered as fast as possible.
+ *
+ *  @sa @ref glfwStartReplay
+ */
+#define GLFW_REPLAY_FAST            0x00060002
 /*! @} */
 
 #define GLFW_DONT_CARE              -1
@@ -1165,6 +1203,145 @@ typedef struct GLFWcursor GLFWcursor;
  */
 typedef void (* GLFWerrorfun)(int,const char*);
 
+/*! @brief The function signature for trace callbacks.
+ *
+ *  This is the function signature for trace callback functions.
+ *
+ *  @param[in] name The name of the internal operation, for example
+ *  `"context.swap_buffers"`.  This is a static string that remains valid for
+ *  the lifetime of the process and is the same pointer for every event of the
+ *  same operation.
+ *  @param[in] begin `GLFW_TRUE` if the operation is beginning, or `GLFW_FALSE`
+ *  if it has ended.
+ *
+ *  @sa @ref intro_trace
+ *  @sa @ref glfwSetTraceCallback
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+typedef void (* GLFWtracefun)(const char*,int);
+
+/*! @brief The function pointer type for memory allocation callbacks.
+ *
+ *  This is the function pointer type for memory allocation callbacks.  A memory
+ *  allocation callback function has the following signature:
+ *  @code
+ *  void* function_name(size_t size, void* user)
+ *  @endcode
+ *
+ *  This function must return either a memory block at least `size` bytes long,
+ *  or `NULL` if allocation failed.  Note that not all parts of GLFW handle
+ *  allocation failures gracefully yet.
+ *
+ *  This function may be called during @ref glfwInit but before the library is
+ *  flagged as initialized, as well as during @ref glfwTerminate after the
+ *  library is no longer flagged as initialized.
+ *
+ *  Any memory allocated by this function will be deallocated during library
+ *  termination or earlier.
+ *
+ *  The size will always be greater than zero.  Allocations of size zero are
+ *  filtered out before reaching the custom allocator.
+ *
+ *  @param[in] size The minimum size, in bytes, of the memory block.
+ *  @param[in] user The user-defined pointer from the allocator.
+ *  @return The address of the newly allocated memory block, or `NULL` if an
+ *  error occurred.
+ *
+ *  @pointer_lifetime The returned memory block must be valid at least until it
+ *  is deallocated.
+ *
+ *  @reentrancy This function should not call any GLFW function.
+ *
+ *  @thread_safety This function may be called from any thread that calls GLFW
+ *  functions.
+ *
+ *  @sa @ref init_allocator
+ *  @sa @ref GLFWallocator
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+typedef void* (* GLFWallocatefun)(size_t size, void* user);
+
+/*! @brief The function pointer type for memory reallocation callbacks.
+ *
+ *  This is the function pointer type for memory reallocation callbacks.
+ *  A memory reallocation callback function has the following signature:
+ *  @code
+ *  void* function_name(void* block, size_t size, void* user)
+ *  @endcode
+ *
+ *  This function must return a memory block at least `size` bytes long, or
+ *  `NULL` if allocation failed.  The contents of the original block up to the
+ *  smaller of the old and new sizes must be preserved.  If the block is moved,
+ *  the original block must be deallocated.
+ *
+ *  The block address will never be `NULL` and the size will always be greater
+ *  than zero.  Reallocations of a block to size zero are converted into
+ *  deallocations.  Reallocations of `NULL` to a non-zero size are converted
+ *  into regular allocations.
+ *
+ *  @param[in] block The address of the memory block to reallocate.
+ *  @param[in] size The new minimum size, in bytes, of the memory block.
+ *  @param[in] user The user-defined pointer from the allocator.
+ *  @return The address of the reallocated memory block, or `NULL` if an error
+ *  occurred.
+ *
+ *  @pointer_lifetime The returned memory block must be valid at least until it
+ *  is deallocated.
+ *
+ *  @reentrancy This function should not call any GLFW function.
+ *
+ *  @thread_safety This function may be called from any thread that calls GLFW
+ *  functions.
+ *
+ *  @sa @ref init_allocator
+ *  @sa @ref GLFWallocator
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+typedef void* (* GLFWreallocatefun)(void* block, size_t size, void* user);
+
+/*! @brief The function pointer type for memory deallocation callbacks.
+ *
+ *  This is the function pointer type for memory deallocation callbacks.
+ *  A memory deallocation callback function has the following signature:
+ *  @code
+ *  void function_name(void* block, void* user)
+ *  @endcode
+ *
+ *  This function may deallocate the specified memory block.  This memory block
+ *  will have been allocated with the same allocator.
+ *
+ *  The block address will never be `NULL`.  Deallocations of `NULL` are
+ *  filtered out before reaching the custom allocator.
+ *
+ *  @param[in] block The address of the memory block to deallocate.
+ *  @param[in] user The user-defined pointer from the allocator.
+ *
+ *  @pointer_lifetime The specified memory block will not be accessed by GLFW
+ *  after this function is called.
+ *
+ *  @reentrancy This function should not call any GLFW function.
+ *
+ *  @thread_safety This function may be called from any thread that calls GLFW
+ *  functions.
+ *
+ *  @sa @ref init_allocator
+ *  @sa @ref GLFWallocator
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+typedef void (* GLFWdeallocatefun)(void* block, void* user);
+
 /*! @brief The function signature for window position callbacks.
  *
  *  This is the function signature for window position callback functions.
@@ -1458,6 +1635,26 @@ typedef void (* GLFWcharfun)(GLFWwindow*,unsigned int);
  */
 typedef void (* GLFWcharmodsfun)(GLFWwindow*,unsigned int,int);
 
+/*! @brief The function signature for UTF-8 text callbacks.
+ *
+ *  This is the function signature for UTF-8 text callback functions.  It is
+ *  called once for each run of text committed by the system text input,
+ *  which may contain more than one character.
+ *
+ *  @param[in] window The window that received the event.
+ *  @param[in] text The UTF-8 encoded, null-terminated text.
+ *
+ *  @pointer_lifetime The text is valid until the callback function returns.
+ *
+ *  @sa @ref input_char
+ *  @sa @ref glfwSetTextCallback
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWtextfun)(GLFWwindow*,const char*);
+
 /*! @brief The function signature for file drop callbacks.
  *
  *  This is the function signature for file drop callbacks.
@@ -1475,6 +1672,42 @@ typedef void (* GLFWcharmodsfun)(GLFWwindow*,unsigned int,int);
  */
 typedef void (* GLFWdropfun)(GLFWwindow*,int,const char**);
 
+/*! @brief The function signature for streaming file drop callbacks.
+ *
+ *  This is the function signature for streaming file drop callbacks.  A single
+ *  drop may be delivered as several consecutive batches of paths.
+ *
+ *  @param[in] window The window that received the event.
+ *  @param[in] count The number of dropped files in this batch.
+ *  @param[in] paths The UTF-8 encoded file and/or directory path names.
+ *  @param[in] last `GLFW_TRUE` if this is the last batch of the drop, or
+ *  `GLFW_FALSE` otherwise.
+ *
+ *  @sa @ref path_drop
+ *  @sa @ref glfwSetDropStreamCallback
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+typedef void (* GLFWdropstreamfun)(GLFWwindow*,int,const char**,int);
+
+/*! @brief The function signature for user event callbacks.
+ *
+ *  This is the function signature for user event callbacks.
+ *
+ *  @param[in] window The window that received the event.
+ *  @param[in] data The data posted with the event.
+ *
+ *  @sa @ref events_user
+ *  @sa @ref glfwSetUserEventCallback
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup window
+ */
+typedef void (* GLFWusereventfun)(GLFWwindow*,uint64_t);
+
 /*! @brief The function signature for monitor configuration callbacks.
  *
  *  This is the function signature for monitor configuration callback functions.
@@ -1622,6 +1855,81 @@ typedef struct GLFWgamepadstate
     float axes[6];
 } GLFWgamepadstate;
 
+/*! @brief Custom heap memory allocator.
+ *
+ *  This describes a custom heap memory allocator for GLFW.  To set an allocator,
+ *  pass it to @ref glfwInitAllocator before initializing the library.
+ *
+ *  @sa @ref init_allocator
+ *  @sa @ref glfwInitAllocator
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+typedef struct GLFWallocator
+{
+    /*! The memory allocation function.  See @ref GLFWallocatefun for details
+     *  about allocation function.
+     */
+    GLFWallocatefun allocate;
+    /*! The memory reallocation function.  See @ref GLFWreallocatefun for
+     *  details about reallocation function.
+     */
+    GLFWreallocatefun reallocate;
+    /*! The memory deallocation function.  See @ref GLFWdeallocatefun for
+     *  details about deallocation function.
+     */
+    GLFWdeallocatefun deallocate;
+    /*! The user pointer for this custom allocator.  This value will be passed
+     *  to the allocator functions.
+     */
+    void* user;
+} GLFWallocator;
+
+/*! @brief Initialization phase.
+ *
+ *  This describes a finished phase of library initialization.
+ *
+ *  @sa @ref init_phases
+ *  @sa @ref glfwGetInitPhases
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+typedef struct GLFWinitphase
+{
+    /*! The name of the phase, for example `"platform"` or `"joysticks"`.
+     */
+    const char* name;
+    /*! The time spent in the phase, in seconds.
+     */
+    double duration;
+} GLFWinitphase;
+
+/*! @brief Internal counter.
+ *
+ *  This describes the number of times GLFW has made a particular kind of
+ *  window system round trip or system call.
+ *
+ *  @sa @ref intro_counters
+ *  @sa @ref glfwGetInternalCounters
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+typedef struct GLFWcounter
+{
+    /*! The name of the counter, for example `"x11.XQueryPointer"`.
+     */
+    const char* name;
+    /*! The number of calls since the counters were last reset.
+     */
+    uint64_t value;
+} GLFWcounter;
+
 
 /*************************************************************************
  * GLFW API functions
@@ -1725,6 +2033,128 @@ GLFWAPI void glfwTerminate(void);
  */
 GLFWAPI void glfwInitHint(int hint, int value);
 
+/*! @brief Sets the init allocator to the desired value.
+ *
+ *  To use the default allocator, call this function with a `NULL` argument.
+ *
+ *  If you specify an allocator struct, every member must be a valid function
+ *  pointer.  If any member is `NULL`, this function will emit @ref
+ *  GLFW_INVALID_VALUE and the init allocator will be unchanged.
+ *
+ *  The functions will be passed the user pointer of the struct, which can for
+ *  example point to an arena or pool owned by the application.
+ *
+ *  Like init hints, the init allocator only takes effect during initialization.
+ *  Every allocation made by GLFW after that point, until it is terminated, goes
+ *  through the same allocator.
+ *
+ *  @param[in] allocator The allocator to use at the next initialization, or
+ *  `NULL` to use the default one.
+ *
+ *  @errors Possible errors include @ref GLFW_INVALID_VALUE.
+ *
+ *  @pointer_lifetime The specified allocator is copied before this function
+ *  returns.
+ *
+ *  @remarks This function may be called before @ref glfwInit.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref init_allocator
+ *  @sa @ref glfwInit
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+GLFWAPI void glfwInitAllocator(const GLFWallocator* allocator);
+
+/*! @brief Returns the startup trace of the library.
+ *
+ *  This function returns an array of the initialization phases that have
+ *  finished since the library was initialized, in the order they finished.
+ *  Phases may be nested, in which case the enclosing phase is listed after the
+ *  phases it contains.
+ *
+ *  Some subsystems, like joysticks and gamepad mappings, are initialized on
+ *  first use instead of by @ref glfwInit.  Their phases are added to the trace
+ *  when that happens.
+ *
+ *  The names and number of phases are platform specific and may change between
+ *  releases.  They are intended for profiling and diagnostics only.
+ *
+ *  @param[out] count Where to store the number of phases in the returned
+ *  array.  This is set to zero if an error occurred.
+ *  @return An array of initialization phases, or `NULL` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @pointer_lifetime The returned array is allocated and freed by GLFW.  You
+ *  should not free it yourself.  It is valid until the library is terminated.
+ *  Phases finishing later do not move existing elements.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref init_phases
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+GLFWAPI const GLFWinitphase* glfwGetInitPhases(int* count);
+
+/*! @brief Returns the internal round trip and system call counters.
+ *
+ *  This function returns an array of counters of the blocking window system
+ *  round trips and system calls made by GLFW since the library was initialized
+ *  or the counters were last reset with @ref glfwResetInternalCounters.  By
+ *  resetting the counters once per frame, a test can verify that a frame does
+ *  not make more round trips than expected.
+ *
+ *  The array always contains every counter, including those of other
+ *  platforms, which remain zero.  The names and number of counters may change
+ *  between releases.  They are intended for testing and diagnostics only.
+ *
+ *  @param[out] count Where to store the number of counters in the returned
+ *  array.  This is set to zero if an error occurred.
+ *  @return An array of counters, or `NULL` if an [error](@ref error_handling)
+ *  occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @pointer_lifetime The returned array is allocated and freed by GLFW.  You
+ *  should not free it yourself.  It is valid until this function is called
+ *  again or the library is terminated.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref intro_counters
+ *  @sa @ref glfwResetInternalCounters
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+GLFWAPI const GLFWcounter* glfwGetInternalCounters(int* count);
+
+/*! @brief Resets the internal round trip and system call counters.
+ *
+ *  This function sets all internal counters to zero.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref intro_counters
+ *  @sa @ref glfwGetInternalCounters
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+GLFWAPI void glfwResetInternalCounters(void);
+
 /*! @brief Retrieves the version of the GLFW library.
  *
  *  This function retrieves the major, minor and revision numbers of the GLFW
@@ -1853,6 +2283,45 @@ GLFWAPI int glfwGetError(const char** description);
  */
 GLFWAPI GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun cbfun);
 
+/*! @brief Sets the trace callback.
+ *
+ *  This function sets the trace callback, which is called when GLFW begins and
+ *  ends internal operations that may take a noticeable amount of time, such as
+ *  processing events, swapping buffers, window system round trips, context
+ *  configuration selection, joystick polling and clipboard transfers.  The
+ *  events can be forwarded to a profiler or written out as trace events in
+ *  the Chrome trace format.  See @ref intro_trace for the list of operations.
+ *
+ *  Operations may be nested but are always ended on the thread and in the
+ *  reverse order they were begun.  The trace callback is called on the thread
+ *  performing the operation.  If you are using GLFW from multiple threads,
+ *  your trace callback needs to be written accordingly.
+ *
+ *  The trace callback must not call any GLFW function other than @ref
+ *  glfwGetTimerValue and @ref glfwGetTimerFrequency.  When no trace callback is
+ *  set, the cost of each traced operation is a single pointer comparison.
+ *
+ *  Once set, the trace callback remains set even after the library has been
+ *  terminated.
+ *
+ *  @param[in] cbfun The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set.
+ *
+ *  @errors None.
+ *
+ *  @remark This function may be called before @ref glfwInit.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref intro_trace
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup init
+ */
+GLFWAPI GLFWtracefun glfwSetTraceCallback(GLFWtracefun cbfun);
+
 /*! @brief Returns the currently connected monitors.
  *
  *  This function returns an array of handles for all currently connected
@@ -2274,6 +2743,11 @@ GLFWAPI const GLFWgammaramp* glfwGetGammaRamp(GLFWmonitor* monitor);
  *
  *  @remark @win32 The gamma ramp size must be 256.
  *
+ *  @remark If the specified gamma ramp is identical to the one last set by
+ *  GLFW for that monitor, this function does nothing.  The ramp is set again
+ *  after @ref glfwGetGammaRamp has been called or the video mode of the monitor
+ *  has been changed by GLFW.
+ *
  *  @remark @wayland Gamma handling is a priviledged protocol, this function
  *  will thus never be implemented and emits @ref GLFW_PLATFORM_ERROR.
  *
@@ -2958,6 +3432,11 @@ GLFWAPI void glfwGetFramebufferSize(GLFWwindow* window, int* width, int* height)
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_PLATFORM_ERROR.
  *
+ *  @remark @x11 If the [GLFW_X11_ASYNC_WINDOWS](@ref GLFW_X11_ASYNC_WINDOWS)
+ *  init hint is set, this function does not wait for the window manager to
+ *  report the frame size of a hidden window and the frame size is zero until it
+ *  has done so.
+ *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref window_size
@@ -3154,6 +3633,11 @@ GLFWAPI void glfwMaximizeWindow(GLFWwindow* window);
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
  *  GLFW_PLATFORM_ERROR.
  *
+ *  @remark @x11 If the [GLFW_X11_ASYNC_WINDOWS](@ref GLFW_X11_ASYNC_WINDOWS)
+ *  init hint is set, this function returns without waiting for the window to
+ *  become visible.  If the window is to be focused, that is done once it has
+ *  become visible.
+ *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref window_hide
@@ -3321,6 +3805,10 @@ GLFWAPI GLFWmonitor* glfwGetWindowMonitor(GLFWwindow* window);
  *  @remark @wayland Setting the window to full screen will not attempt to
  *  change the mode, no matter what the requested size or refresh rate.
  *
+ *  @remark @x11 If the [GLFW_X11_ASYNC_WINDOWS](@ref GLFW_X11_ASYNC_WINDOWS)
+ *  init hint is set and the window is hidden, the video mode is set when the
+ *  window has become visible instead of before this function returns.
+ *
  *  @thread_safety This function must only be called from the main thread.
  *
  *  @sa @ref window_monitor
@@ -3813,6 +4301,7 @@ GLFWAPI void glfwWaitEvents(void);
  *  @sa @ref events
  *  @sa @ref glfwPollEvents
  *  @sa @ref glfwWaitEvents
+ *  @sa @ref glfwWaitEventsUntil
  *
  *  @since Added in version 3.2.
  *
@@ -3820,6 +4309,52 @@ GLFWAPI void glfwWaitEvents(void);
  */
 GLFWAPI void glfwWaitEventsTimeout(double timeout);
 
+/*! @brief Waits until events are queued or a deadline is reached and processes
+ *  them.
+ *
+ *  This function puts the calling thread to sleep until at least one event is
+ *  available in the event queue, or until the [raw timer](@ref
+ *  glfwGetTimerValue) reaches the specified value.  If one or more events are
+ *  available, it behaves exactly like @ref glfwPollEvents, i.e. the events in
+ *  the queue are processed and the function then returns immediately.  If the
+ *  deadline has already passed, it also behaves like @ref glfwPollEvents.
+ *
+ *  Unlike @ref glfwWaitEventsTimeout, the deadline is absolute, so a loop
+ *  waiting for a series of deadlines does not accumulate drift from the time
+ *  spent outside of this function.  Where supported, the wait has nanosecond
+ *  resolution, in which case the precision is limited by the scheduler of
+ *  the operating system.
+ *
+ *  Since not all events are associated with callbacks, this function may return
+ *  without a callback having been called even if you are monitoring all
+ *  callbacks.
+ *
+ *  Event processing is not required for joystick input to work.
+ *
+ *  @param[in] deadline The value of the raw timer at which to stop waiting.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @remark @x11 @wayland On Linux, the wait has nanosecond resolution.  On
+ *  other Unix systems it is rounded up to whole milliseconds.
+ *
+ *  @remark @win32 The wait is rounded up to whole milliseconds.
+ *
+ *  @reentrancy This function must not be called from a callback.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref events
+ *  @sa @ref glfwWaitEventsTimeout
+ *  @sa @ref glfwGetTimerValue
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup window
+ */
+GLFWAPI void glfwWaitEventsUntil(uint64_t deadline);
+
 /*! @brief Posts an empty event to the event queue.
  *
  *  This function posts an empty event from the current thread to the event
@@ -3840,6 +4375,69 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout);
  */
 GLFWAPI void glfwPostEmptyEvent(void);
 
+/*! @brief Posts a user event to the specified window.
+ *
+ *  This function posts a user event with the specified data from the current
+ *  thread to the specified window, causing @ref glfwWaitEvents or @ref
+ *  glfwWaitEventsTimeout to return.  The event is passed to the [user event
+ *  callback](@ref glfwSetUserEventCallback) of the window by the next call to
+ *  @ref glfwPollEvents, @ref glfwWaitEvents, @ref glfwWaitEventsTimeout or
+ *  @ref glfwWaitEventsUntil.  Events posted from a single thread are delivered
+ *  in the order they were posted.
+ *
+ *  User events are stored in a lock-free queue with room for 1024 events.  If
+ *  the queue is full, the event is not posted and this function returns
+ *  `GLFW_FALSE`.  Only the first event posted after the queue has been drained
+ *  causes a wakeup of the event loop.
+ *
+ *  Events posted to a window that is destroyed before they are delivered are
+ *  discarded.
+ *
+ *  @param[in] window The window to post the event to.
+ *  @param[in] data The data to pass to the callback.
+ *  @return `GLFW_TRUE` if the event was posted, or `GLFW_FALSE` if the queue
+ *  was full or an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function may be called from any thread, but the window
+ *  must not be destroyed while this function is running.
+ *
+ *  @sa @ref events_user
+ *  @sa @ref glfwSetUserEventCallback
+ *  @sa @ref glfwPostEmptyEvent
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup window
+ */
+GLFWAPI int glfwPostUserEvent(GLFWwindow* window, uint64_t data);
+
+/*! @brief Sets the user event callback for the specified window.
+ *
+ *  This function sets the user event callback of the specified window, which
+ *  is called when a user event posted with @ref glfwPostUserEvent is delivered.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] cbfun The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref events_user
+ *  @sa @ref glfwPostUserEvent
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup window
+ */
+GLFWAPI GLFWusereventfun glfwSetUserEventCallback(GLFWwindow* window, GLFWusereventfun cbfun);
+
 /*! @brief Returns the value of an input option for the specified window.
  *
  *  This function returns the value of an input option for the specified window.
@@ -4207,6 +4805,11 @@ GLFWAPI void glfwSetCursorPos(GLFWwindow* window, double xpos, double ypos);
  *  of the cursor image.  Like all other coordinate systems in GLFW, the X-axis
  *  points to the right and the Y-axis points down.
  *
+ *  Cursors are cached by their image and hotspot.  Creating a cursor identical
+ *  to an existing or recently destroyed one returns the same handle without
+ *  creating a new native cursor.  Each successful call must be balanced by
+ *  a call to @ref glfwDestroyCursor.
+ *
  *  @param[in] image The desired cursor image.
  *  @param[in] xhot The desired x-coordinate, in pixels, of the cursor hotspot.
  *  @param[in] yhot The desired y-coordinate, in pixels, of the cursor hotspot.
@@ -4236,6 +4839,10 @@ GLFWAPI GLFWcursor* glfwCreateCursor(const GLFWimage* image, int xhot, int yhot)
  *  Returns a cursor with a [standard shape](@ref shapes), that can be set for
  *  a window with @ref glfwSetCursor.
  *
+ *  Cursors are cached by shape.  Creating a cursor with the same shape as an
+ *  existing or recently destroyed one returns the same handle.  Each successful
+ *  call must be balanced by a call to @ref glfwDestroyCursor.
+ *
  *  @param[in] shape One of the [standard shapes](@ref shapes).
  *  @return A new cursor ready to use or `NULL` if an
  *  [error](@ref error_handling) occurred.
@@ -4263,6 +4870,11 @@ GLFWAPI GLFWcursor* glfwCreateStandardCursor(int shape);
  *  If the specified cursor is current for any window, that window will be
  *  reverted to the default cursor.  This does not affect the cursor mode.
  *
+ *  If the same cursor was created more than once, it is only destroyed once
+ *  every handle has been destroyed.  The native cursor may then be kept for
+ *  reuse by later calls to @ref glfwCreateCursor or @ref
+ *  glfwCreateStandardCursor.
+ *
  *  @param[in] cursor The cursor object to destroy.
  *
  *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
@@ -4422,6 +5034,40 @@ GLFWAPI GLFWcharfun glfwSetCharCallback(GLFWwindow* window, GLFWcharfun cbfun);
  */
 GLFWAPI GLFWcharmodsfun glfwSetCharModsCallback(GLFWwindow* window, GLFWcharmodsfun cbfun);
 
+/*! @brief Sets the UTF-8 text callback.
+ *
+ *  This function sets the text callback of the specified window, which is
+ *  called when text is input.
+ *
+ *  The text callback receives the same text as the
+ *  [character callback](@ref glfwSetCharCallback), but as UTF-8 strings
+ *  instead of individual code points.  Where the system text input commits
+ *  several characters at once, for example the result of an input method
+ *  composition, the whole run is delivered in a single call.  Depending on the
+ *  platform, text may also be delivered one character per call.
+ *
+ *  If both a text callback and character callbacks are set, the text callback
+ *  is called first, followed by the character callbacks for each character in
+ *  the text.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] cbfun The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_char
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWtextfun glfwSetTextCallback(GLFWwindow* window, GLFWtextfun cbfun);
+
 /*! @brief Sets the mouse button callback.
  *
  *  This function sets the mouse button callback of the specified window, which
@@ -4558,6 +5204,40 @@ GLFWAPI GLFWscrollfun glfwSetScrollCallback(GLFWwindow* window, GLFWscrollfun cb
  */
 GLFWAPI GLFWdropfun glfwSetDropCallback(GLFWwindow* window, GLFWdropfun cbfun);
 
+/*! @brief Sets the streaming file drop callback.
+ *
+ *  This function sets the streaming file drop callback of the specified
+ *  window, which is called with batches of paths as they are decoded when one
+ *  or more dragged files are dropped on the window.  This lets you start
+ *  processing a very large drop before all of its paths have been decoded.
+ *
+ *  The last batch of each drop has the `last` argument set to `GLFW_TRUE`.
+ *  A batch may be empty.  If a [file drop callback](@ref glfwSetDropCallback)
+ *  is also set, or on platforms that provide the whole list at once, the paths
+ *  are delivered in a single batch.
+ *
+ *  The path array and its strings are only valid until the callback returns.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] cbfun The new streaming file drop callback, or `NULL` to remove
+ *  the currently set callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or the
+ *  library had not been [initialized](@ref intro_init).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @remark @wayland File drop is currently unimplemented.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref path_drop
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI GLFWdropstreamfun glfwSetDropStreamCallback(GLFWwindow* window, GLFWdropstreamfun cbfun);
+
 /*! @brief Returns whether the specified joystick is present.
  *
  *  This function returns whether the specified joystick is present.
@@ -5145,6 +5825,157 @@ GLFWAPI uint64_t glfwGetTimerValue(void);
  */
 GLFWAPI uint64_t glfwGetTimerFrequency(void);
 
+/*! @brief Advances the virtual clock.
+ *
+ *  This function advances the virtual clock by the specified number of timer
+ *  units.  The frequency of the virtual clock is returned by @ref
+ *  glfwGetTimerFrequency.  The virtual clock is enabled with the @ref
+ *  GLFW_VIRTUAL_CLOCK init hint and only advances when this function is
+ *  called, when @ref glfwWaitEventsTimeout lets its timeout pass or, on the
+ *  null platform, when an injected time step is processed.
+ *
+ *  @param[in] delta The number of timer units to advance the clock by.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref time_virtual
+ *  @sa @ref glfwGetTimerValue
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwAdvanceTimerValue(uint64_t delta);
+
+/*! @brief Starts recording input to the specified file.
+ *
+ *  This function starts recording all input and window events received by
+ *  GLFW to the specified file, as a compact binary trace with timestamps from
+ *  the [raw timer](@ref glfwGetTimerValue).  If a recording is already in
+ *  progress, it is stopped first.
+ *
+ *  Events are written through a buffer and the trace is only guaranteed to be
+ *  complete after @ref glfwStopRecording is called or the library is
+ *  terminated.  Windows are identified in the trace by the order in which they
+ *  were created.  Joystick input is not recorded.
+ *
+ *  @param[in] path The path of the trace file to write.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_record
+ *  @sa @ref glfwStopRecording
+ *  @sa @ref glfwStartReplay
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwStartRecording(const char* path);
+
+/*! @brief Stops recording input.
+ *
+ *  This function stops any input recording in progress and finishes writing
+ *  its trace file.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_record
+ *  @sa @ref glfwStartRecording
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwStopRecording(void);
+
+/*! @brief Starts replaying input from the specified file.
+ *
+ *  This function starts replaying the input trace in the specified file.  The
+ *  replayed events are delivered by @ref glfwPollEvents, @ref glfwWaitEvents
+ *  and @ref glfwWaitEventsTimeout, after any events from the window system, to
+ *  the windows created in the same order as the recorded ones.  If a replay is
+ *  already in progress, it is stopped first.
+ *
+ *  With `GLFW_REPLAY_REALTIME`, events are delivered when as much time has
+ *  passed since this function was called as had when they were recorded, and
+ *  the wait functions return when the next event is due.  With
+ *  `GLFW_REPLAY_FAST`, each event processing call delivers the events of one
+ *  recorded event processing call and the wait functions do not wait.  If the
+ *  [virtual clock](@ref time_virtual) is enabled, fast replay also advances it
+ *  to the recorded times.
+ *
+ *  The replay stops when the end of the trace is reached.
+ *
+ *  @param[in] path The path of the trace file to replay.
+ *  @param[in] mode `GLFW_REPLAY_REALTIME` or `GLFW_REPLAY_FAST`.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_ENUM, @ref GLFW_INVALID_VALUE and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_record
+ *  @sa @ref glfwStopReplay
+ *  @sa @ref glfwReplayActive
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwStartReplay(const char* path, int mode);
+
+/*! @brief Stops replaying input.
+ *
+ *  This function stops any input replay in progress.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_record
+ *  @sa @ref glfwStartReplay
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI void glfwStopReplay(void);
+
+/*! @brief Returns whether an input replay is in progress.
+ *
+ *  This function returns whether an input replay is in progress, i.e. whether
+ *  it has been started and has neither reached the end of its trace nor been
+ *  stopped.
+ *
+ *  @return `GLFW_TRUE` if a replay is in progress, or `GLFW_FALSE` otherwise.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa @ref input_record
+ *  @sa @ref glfwStartReplay
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup input
+ */
+GLFWAPI int glfwReplayActive(void);
+
 /*! @brief Makes the context of the specified window current for the calling
  *  thread.
  *
@@ -5519,6 +6350,30 @@ GLFWAPI GLFWvkproc glfwGetInstanceProcAddress(VkInstance instance, const char* p
  */
 GLFWAPI int glfwGetPhysicalDevicePresentationSupport(VkInstance instance, VkPhysicalDevice device, uint32_t queuefamily);
 
+/*! @brief Discards cached Vulkan data for the specified instance.
+ *
+ *  This function discards the entry point addresses and queue family
+ *  presentation support cached for the specified instance.  If the @ref
+ *  GLFW_VULKAN_CACHE init hint is enabled, call this function before
+ *  destroying an instance, as a later instance may be given the same handle.
+ *
+ *  If instance is set to `NULL`, all cached data is discarded, including the
+ *  global entry point addresses that are always cached.
+ *
+ *  @param[in] instance The instance about to be destroyed, or `NULL`.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa @ref vulkan_cache
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup vulkan
+ */
+GLFWAPI void glfwInvalidateVulkanCache(VkInstance instance);
+
 /*! @brief Creates a Vulkan surface for the specified window.
  *
  *  This function creates a Vulkan surface for the specified window.
@@ -62,6 +62,7 @@ extern "C" {
  *  * `GLFW_EXPOSE_NATIVE_COCOA`
  *  * `GLFW_EXPOSE_NATIVE_X11`
  *  * `GLFW_EXPOSE_NATIVE_WAYLAND`
+ *  * `GLFW_EXPOSE_NATIVE_NULL`
  *
  *  The available context API macros are:
  *  * `GLFW_EXPOSE_NATIVE_WGL`
@@ -415,6 +416,501 @@ GLFWAPI struct wl_output* glfwGetWaylandMonitor(GLFWmonitor* monitor);
 GLFWAPI struct wl_surface* glfwGetWaylandWindow(GLFWwindow* window);
 #endif
 
+#if defined(GLFW_EXPOSE_NATIVE_NULL)
+/*! @brief Connects a virtual monitor with the specified video modes.
+ *
+ *  This function creates a virtual monitor for the null platform.  The monitor
+ *  is connected, and the [monitor callback](@ref monitor_event) called, during
+ *  the next call to @ref glfwPollEvents, @ref glfwWaitEvents or @ref
+ *  glfwWaitEventsTimeout.  The first video mode in the array becomes the
+ *  current and desktop mode of the monitor.
+ *
+ *  A default virtual monitor is connected when the library is initialized.
+ *
+ *  @param[in] name The human-readable name of the monitor.
+ *  @param[in] widthMM The physical width of the monitor, in millimetres.
+ *  @param[in] heightMM The physical height of the monitor, in millimetres.
+ *  @param[in] modes The video modes supported by the monitor.
+ *  @param[in] count The number of video modes in the array.
+ *  @return The handle of the new monitor, or `NULL` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @pointer_lifetime The specified name and video modes are copied before this
+ *  function returns.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa glfwNullDisconnectMonitor
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI GLFWmonitor* glfwNullConnectMonitor(const char* name, int widthMM, int heightMM, const GLFWvidmode* modes, int count);
+
+/*! @brief Disconnects the specified virtual monitor.
+ *
+ *  This function queues the disconnection of the specified monitor.  The
+ *  monitor is disconnected and destroyed during the next event processing
+ *  call.  Full screen windows on the monitor are made windowed.
+ *
+ *  @param[in] monitor The monitor to disconnect.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa glfwNullConnectMonitor
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullDisconnectMonitor(GLFWmonitor* monitor);
+
+/*! @brief Sets the position of the specified virtual monitor.
+ *
+ *  @param[in] monitor The monitor to modify.
+ *  @param[in] xpos The x-coordinate of the upper-left corner of the monitor.
+ *  @param[in] ypos The y-coordinate of the upper-left corner of the monitor.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullSetMonitorPos(GLFWmonitor* monitor, int xpos, int ypos);
+
+/*! @brief Sets the content scale of the specified virtual monitor.
+ *
+ *  @param[in] monitor The monitor to modify.
+ *  @param[in] xscale The new x-axis content scale of the monitor.
+ *  @param[in] yscale The new y-axis content scale of the monitor.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullSetMonitorContentScale(GLFWmonitor* monitor, float xscale, float yscale);
+
+/*! @brief Sets the work area of the specified virtual monitor.
+ *
+ *  @param[in] monitor The monitor to modify.
+ *  @param[in] xpos The x-coordinate of the work area, relative to the
+ *  position of the monitor.
+ *  @param[in] ypos The y-coordinate of the work area, relative to the
+ *  position of the monitor.
+ *  @param[in] width The width of the work area.
+ *  @param[in] height The height of the work area.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullSetMonitorWorkarea(GLFWmonitor* monitor, int xpos, int ypos, int width, int height);
+
+/*! @brief Injects a physical key event into the specified window.
+ *
+ *  This function queues a key event for the specified window.  Like all
+ *  injected events, it is processed by the next call to @ref glfwPollEvents,
+ *  @ref glfwWaitEvents or @ref glfwWaitEventsTimeout, which will also return
+ *  when an event is injected.  Injected events are delivered in the order they
+ *  were injected and go through the same processing as events from a window
+ *  system.
+ *
+ *  Key events do not generate character events.  Use @ref glfwNullInjectChar
+ *  to inject text input.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] key The [key](@ref keys) to inject, or `GLFW_KEY_UNKNOWN`.
+ *  @param[in] scancode The scancode of the key, or a negative value to use
+ *  the scancode of the specified key.
+ *  @param[in] action `GLFW_PRESS`, `GLFW_RELEASE` or `GLFW_REPEAT`.
+ *  @param[in] mods Bit field describing which [modifier keys](@ref mods) were
+ *  held down.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_ENUM.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectKey(GLFWwindow* window, int key, int scancode, int action, int mods);
+
+/*! @brief Injects a Unicode character event into the specified window.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] codepoint The Unicode code point of the character.
+ *  @param[in] mods Bit field describing which [modifier keys](@ref mods) were
+ *  held down.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa glfwNullInjectKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectChar(GLFWwindow* window, unsigned int codepoint, int mods);
+
+/*! @brief Injects a mouse button event into the specified window.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] button The [mouse button](@ref buttons) to inject.
+ *  @param[in] action `GLFW_PRESS` or `GLFW_RELEASE`.
+ *  @param[in] mods Bit field describing which [modifier keys](@ref mods) were
+ *  held down.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_ENUM.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa glfwNullInjectKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectMouseButton(GLFWwindow* window, int button, int action, int mods);
+
+/*! @brief Injects a cursor motion event into the specified window.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] xpos The new x-coordinate of the cursor, relative to the left
+ *  edge of the content area.
+ *  @param[in] ypos The new y-coordinate of the cursor, relative to the top
+ *  edge of the content area.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa glfwNullInjectKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectCursorPos(GLFWwindow* window, double xpos, double ypos);
+
+/*! @brief Injects a cursor enter or leave event into the specified window.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] entered `GLFW_TRUE` if the cursor entered the content area, or
+ *  `GLFW_FALSE` if it left it.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa glfwNullInjectKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectCursorEnter(GLFWwindow* window, int entered);
+
+/*! @brief Injects a scroll event into the specified window.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] xoffset The scroll offset along the x-axis.
+ *  @param[in] yoffset The scroll offset along the y-axis.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa glfwNullInjectKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectScroll(GLFWwindow* window, double xoffset, double yoffset);
+
+/*! @brief Injects a window move by the user into the specified window.
+ *
+ *  This event is ignored for full screen windows.
+ *
+ *  @param[in] window The window to move.
+ *  @param[in] xpos The new x-coordinate of the upper-left corner of the
+ *  content area.
+ *  @param[in] ypos The new y-coordinate of the upper-left corner of the
+ *  content area.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa glfwNullInjectKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectWindowPos(GLFWwindow* window, int xpos, int ypos);
+
+/*! @brief Injects a window resize by the user into the specified window.
+ *
+ *  The size limits and aspect ratio of the window are applied to the new size.
+ *  This event is ignored for full screen windows.
+ *
+ *  @param[in] window The window to resize.
+ *  @param[in] width The new width of the content area.
+ *  @param[in] height The new height of the content area.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa glfwNullInjectKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectWindowSize(GLFWwindow* window, int width, int height);
+
+/*! @brief Injects a change of input focus into the specified window.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] focused `GLFW_TRUE` if the window gained input focus, or
+ *  `GLFW_FALSE` if it lost it.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa glfwNullInjectKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectWindowFocus(GLFWwindow* window, int focused);
+
+/*! @brief Injects an iconification or restoration of the specified window.
+ *
+ *  @param[in] window The window to receive the event.
+ *  @param[in] iconified `GLFW_TRUE` if the window was iconified, or
+ *  `GLFW_FALSE` if it was restored.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa glfwNullInjectKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectWindowIconify(GLFWwindow* window, int iconified);
+
+/*! @brief Injects a close request by the user into the specified window.
+ *
+ *  @param[in] window The window to receive the event.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa glfwNullInjectKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectWindowClose(GLFWwindow* window);
+
+/*! @brief Injects a step of the virtual clock.
+ *
+ *  This function queues a step of the virtual clock, which is applied with
+ *  @ref glfwAdvanceTimerValue when the event is processed.  This lets scripted
+ *  input carry its own timing, in order with the other injected events.
+ *
+ *  @param[in] delta The number of timer units to advance the clock by.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @remark This function requires the @ref GLFW_VIRTUAL_CLOCK init hint.
+ *
+ *  @thread_safety This function may be called from any thread.
+ *
+ *  @sa glfwNullInjectKey
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullInjectTimeStep(uint64_t delta);
+
+/*! @brief The function pointer type for null framebuffer callbacks.
+ *
+ *  This is the function pointer type for null framebuffer callbacks.  A null
+ *  framebuffer callback function has the following signature:
+ *  @code
+ *  void function_name(GLFWwindow* window, const unsigned char* pixels, int width, int height, int stride)
+ *  @endcode
+ *
+ *  @param[in] window The window whose framebuffer was unmapped.
+ *  @param[in] pixels The pixel data of the framebuffer, as 8-bit RGBA rows
+ *  starting at the top.
+ *  @param[in] width The width, in pixels, of the framebuffer.
+ *  @param[in] height The height, in pixels, of the framebuffer.
+ *  @param[in] stride The distance, in bytes, between the starts of two rows.
+ *
+ *  @pointer_lifetime The pixel data is valid until the callback returns.
+ *
+ *  @sa glfwNullSetFramebufferCallback
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+typedef void (* GLFWnullframebufferfun)(GLFWwindow*,const unsigned char*,int,int,int);
+
+/*! @brief Maps the software framebuffer of the specified window.
+ *
+ *  This function maps the software framebuffer of the specified window for
+ *  direct writes and returns a pointer to its pixels.  The framebuffer is
+ *  allocated when it is first mapped, is initially transparent black and has
+ *  the same size as the framebuffer size of the window.  Pixels are stored as
+ *  8-bit RGBA, with rows starting at the top.
+ *
+ *  The framebuffer must be unmapped with @ref glfwNullUnmapFramebuffer before
+ *  it can be mapped again.  If the window is resized while the framebuffer is
+ *  mapped, the framebuffer keeps its size until it is unmapped.
+ *
+ *  The software framebuffer does not require OSMesa and is available for
+ *  windows with any client API.
+ *
+ *  @param[in] window The window whose framebuffer to map.
+ *  @param[out] width Where to store the width, in pixels, of the framebuffer,
+ *  or `NULL`.
+ *  @param[out] height Where to store the height, in pixels, of the
+ *  framebuffer, or `NULL`.
+ *  @param[out] stride Where to store the distance, in bytes, between the
+ *  starts of two rows, or `NULL`.
+ *  @return The pixels of the framebuffer, or `NULL` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_OUT_OF_MEMORY.
+ *
+ *  @pointer_lifetime The returned pointer is valid until the framebuffer is
+ *  unmapped or the window is destroyed.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa glfwNullUnmapFramebuffer
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI unsigned char* glfwNullMapFramebuffer(GLFWwindow* window, int* width, int* height, int* stride);
+
+/*! @brief Unmaps the software framebuffer of the specified window.
+ *
+ *  This function unmaps the software framebuffer of the specified window and
+ *  passes its contents to the [framebuffer callback](@ref
+ *  glfwNullSetFramebufferCallback), if one is set.  If the window was resized
+ *  while the framebuffer was mapped, the framebuffer is then resized, keeping
+ *  the pixels that fit the new size.
+ *
+ *  @param[in] window The window whose framebuffer to unmap.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_INVALID_VALUE and @ref GLFW_OUT_OF_MEMORY.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa glfwNullMapFramebuffer
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI void glfwNullUnmapFramebuffer(GLFWwindow* window);
+
+/*! @brief Sets the framebuffer callback for the specified window.
+ *
+ *  This function sets the framebuffer callback of the specified window, which
+ *  is called each time its software framebuffer is unmapped.  This can be
+ *  used to stream frames to a file, a video encoder or a test harness.
+ *
+ *  @param[in] window The window whose callback to set.
+ *  @param[in] callback The new callback, or `NULL` to remove the currently set
+ *  callback.
+ *  @return The previously set callback, or `NULL` if no callback was set or
+ *  the library had not been [initialized](@ref intro_init).
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa glfwNullUnmapFramebuffer
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI GLFWnullframebufferfun glfwNullSetFramebufferCallback(GLFWwindow* window, GLFWnullframebufferfun callback);
+
+/*! @brief Writes the software framebuffer of the specified window to a file.
+ *
+ *  This function writes the contents of the software framebuffer of the
+ *  specified window to the specified file as a
+ *  [PAM](http://netpbm.sourceforge.net/doc/pam.html) image with the
+ *  `RGB_ALPHA` tuple type.
+ *
+ *  @param[in] window The window whose framebuffer to write.
+ *  @param[in] path The path of the file to write.
+ *  @return `GLFW_TRUE` if successful, or `GLFW_FALSE` if an
+ *  [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED, @ref
+ *  GLFW_OUT_OF_MEMORY and @ref GLFW_PLATFORM_ERROR.
+ *
+ *  @thread_safety This function must only be called from the main thread.
+ *
+ *  @sa glfwNullMapFramebuffer
+ *
+ *  @since Added in version 3.3.
+ *
+ *  @ingroup native
+ */
+GLFWAPI int glfwNullWriteFramebuffer(GLFWwindow* window, const char* path);
+#endif
+
 #if defined(GLFW_EXPOSE_NATIVE_EGL)
 /*! @brief Returns the `EGLDisplay` used by GLFW.
  *
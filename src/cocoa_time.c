@@ -35,7 +35,7 @@
 
 // Initialise timer
 //
-void _glfwInitTimerNS(void)
+void _glfwPlatformInitTimer(void)
 {
     mach_timebase_info_data_t info;
     mach_timebase_info(&info);
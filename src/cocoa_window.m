@@ -645,7 +645,7 @@ static const NSRange kEmptyRange = { NSNotFound, 0 };
     const NSUInteger count = [urls count];
     if (count)
     {
-        char** paths = calloc(count, sizeof(char*));
+        char** paths = _glfw_calloc(count, sizeof(char*));
 
         for (NSUInteger i = 0;  i < count;  i++)
             paths[i] = _glfw_strdup([urls[i] fileSystemRepresentation]);
@@ -653,8 +653,8 @@ static const NSRange kEmptyRange = { NSNotFound, 0 };
         _glfwInputDrop(window, (int) count, (const char**) paths);
 
         for (NSUInteger i = 0;  i < count;  i++)
-            free(paths[i]);
-        free(paths);
+            _glfw_free(paths[i]);
+        _glfw_free(paths);
     }
 
     return YES;
@@ -1428,6 +1428,19 @@ void _glfwPlatformWaitEventsTimeout(double timeout)
     } // autoreleasepool
 }
 
+void _glfwPlatformWaitEventsUntil(uint64_t deadline)
+{
+    const uint64_t now = _glfwPlatformGetTimerValue();
+
+    if (deadline > now)
+    {
+        _glfwPlatformWaitEventsTimeout((deadline - now) /
+                                       (double) _glfwPlatformGetTimerFrequency());
+    }
+    else
+        _glfwPlatformPollEvents();
+}
+
 void _glfwPlatformPostEmptyEvent(void)
 {
     @autoreleasepool {
@@ -1664,7 +1677,7 @@ const char* _glfwPlatformGetClipboardString(void)
         return NULL;
     }
 
-    free(_glfw.ns.clipboardString);
+    _glfw_free(_glfw.ns.clipboardString);
     _glfw.ns.clipboardString = _glfw_strdup([object UTF8String]);
 
     return _glfw.ns.clipboardString;
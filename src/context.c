@@ -622,6 +622,8 @@ GLFWAPI void glfwMakeContextCurrent(GLFWwindow* handle)
         return;
     }
 
+    _GLFW_TRACE_BEGIN("context.make_current");
+
     if (previous)
     {
         if (!window || window->context.source != previous->context.source)
@@ -630,6 +632,8 @@ GLFWAPI void glfwMakeContextCurrent(GLFWwindow* handle)
 
     if (window)
         window->context.makeCurrent(window);
+
+    _GLFW_TRACE_END("context.make_current");
 }
 
 GLFWAPI GLFWwindow* glfwGetCurrentContext(void)
@@ -652,7 +656,9 @@ GLFWAPI void glfwSwapBuffers(GLFWwindow* handle)
         return;
     }
 
+    _GLFW_TRACE_BEGIN("context.swap_buffers");
     window->context.swapBuffers(window);
+    _GLFW_TRACE_END("context.swap_buffers");
 }
 
 GLFWAPI void glfwSwapInterval(int interval)
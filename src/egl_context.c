@@ -101,10 +101,10 @@ static GLFWbool chooseEGLConfig(const _GLFWctxconfig* ctxconfig,
         return GLFW_FALSE;
     }
 
-    nativeConfigs = calloc(nativeCount, sizeof(EGLConfig));
+    nativeConfigs = _glfw_calloc(nativeCount, sizeof(EGLConfig));
     eglGetConfigs(_glfw.egl.display, nativeConfigs, nativeCount, &nativeCount);
 
-    usableConfigs = calloc(nativeCount, sizeof(_GLFWfbconfig));
+    usableConfigs = _glfw_calloc(nativeCount, sizeof(_GLFWfbconfig));
     usableCount = 0;
 
     for (i = 0;  i < nativeCount;  i++)
@@ -180,8 +180,8 @@ static GLFWbool chooseEGLConfig(const _GLFWctxconfig* ctxconfig,
     if (closest)
         *result = (EGLConfig) closest->handle;
 
-    free(nativeConfigs);
-    free(usableConfigs);
+    _glfw_free(nativeConfigs);
+    _glfw_free(usableConfigs);
 
     return closest != NULL;
 }
@@ -461,6 +461,7 @@ GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
     EGLConfig config;
     EGLContext share = NULL;
     int index = 0;
+    GLFWbool found;
 
     if (!_glfw.egl.display)
     {
@@ -471,7 +472,11 @@ GLFWbool _glfwCreateContextEGL(_GLFWwindow* window,
     if (ctxconfig->share)
         share = ctxconfig->share->context.egl.handle;
 
-    if (!chooseEGLConfig(ctxconfig, fbconfig, &config))
+    _GLFW_TRACE_BEGIN("context.choose_config");
+    found = chooseEGLConfig(ctxconfig, fbconfig, &config);
+    _GLFW_TRACE_END("context.choose_config");
+
+    if (!found)
     {
         _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
                         "EGL: Failed to find a suitable EGLConfig");
@@ -715,8 +720,13 @@ GLFWbool _glfwChooseVisualEGL(const _GLFWwndconfig* wndconfig,
     EGLConfig native;
     EGLint visualID = 0, count = 0;
     const long vimask = VisualScreenMask | VisualIDMask;
+    GLFWbool found;
+
+    _GLFW_TRACE_BEGIN("context.choose_config");
+    found = chooseEGLConfig(ctxconfig, fbconfig, &native);
+    _GLFW_TRACE_END("context.choose_config");
 
-    if (!chooseEGLConfig(ctxconfig, fbconfig, &native))
+    if (!found)
     {
         _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
                         "EGL: Failed to find a suitable EGLConfig");
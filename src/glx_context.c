@@ -71,7 +71,7 @@ static GLFWbool chooseGLXFBConfig(const _GLFWfbconfig* desired,
         return GLFW_FALSE;
     }
 
-    usableConfigs = calloc(nativeCount, sizeof(_GLFWfbconfig));
+    usableConfigs = _glfw_calloc(nativeCount, sizeof(_GLFWfbconfig));
     usableCount = 0;
 
     for (i = 0;  i < nativeCount;  i++)
@@ -135,7 +135,7 @@ static GLFWbool chooseGLXFBConfig(const _GLFWfbconfig* desired,
         *result = (GLXFBConfig) closest->handle;
 
     XFree(nativeConfigs);
-    free(usableConfigs);
+    _glfw_free(usableConfigs);
 
     return closest != NULL;
 }
@@ -449,11 +449,16 @@ GLFWbool _glfwCreateContextGLX(_GLFWwindow* window,
     int attribs[40];
     GLXFBConfig native = NULL;
     GLXContext share = NULL;
+    GLFWbool found;
 
     if (ctxconfig->share)
         share = ctxconfig->share->context.glx.handle;
 
-    if (!chooseGLXFBConfig(fbconfig, &native))
+    _GLFW_TRACE_BEGIN("context.choose_config");
+    found = chooseGLXFBConfig(fbconfig, &native);
+    _GLFW_TRACE_END("context.choose_config");
+
+    if (!found)
     {
         _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
                         "GLX: Failed to find a suitable GLXFBConfig");
@@ -640,8 +645,13 @@ GLFWbool _glfwChooseVisualGLX(const _GLFWwndconfig* wndconfig,
 {
     GLXFBConfig native;
     XVisualInfo* result;
+    GLFWbool found;
+
+    _GLFW_TRACE_BEGIN("context.choose_config");
+    found = chooseGLXFBConfig(fbconfig, &native);
+    _GLFW_TRACE_END("context.choose_config");
 
-    if (!chooseGLXFBConfig(fbconfig, &native))
+    if (!found)
     {
         _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
                         "GLX: Failed to find a suitable GLXFBConfig");
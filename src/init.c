@@ -26,7 +26,6 @@
 //========================================================================
 
 #include "internal.h"
-#include "mappings.h"
 
 #include <string.h>
 #include <stdlib.h>
@@ -43,20 +42,68 @@
 //
 _GLFWlibrary _glfw = { GLFW_FALSE };
 
+// The trace callback, read by the _GLFW_TRACE_* macros
+//
+GLFWtracefun _glfwTraceCallback = NULL;
+
 // These are outside of _glfw so they can be used before initialization and
 // after termination
 //
+#if defined(_GLFW_THREAD_LOCAL)
+static _GLFW_THREAD_LOCAL _GLFWerror _glfwThreadError;
+#else
 static _GLFWerror _glfwMainThreadError;
+#endif
 static GLFWerrorfun _glfwErrorCallback;
+static GLFWallocator _glfwInitAllocator;
 static _GLFWinitconfig _glfwInitHints =
 {
     GLFW_TRUE,      // hat buttons
+    GLFW_FALSE,     // virtual clock
+    GLFW_FALSE,     // TSC timer
+    GLFW_FALSE,     // Vulkan cache
     {
         GLFW_TRUE,  // macOS menu bar
         GLFW_TRUE   // macOS bundle chdir
+    },
+    {
+        GLFW_FALSE  // X11 async windows
     }
 };
 
+// The names of the internal counters, indexed by _GLFW_COUNTER_*
+//
+static const char* counterNames[_GLFW_COUNTER_COUNT] =
+{
+    "x11.XGetWindowProperty",
+    "x11.XGetWindowAttributes",
+    "x11.XQueryPointer",
+    "x11.XTranslateCoordinates",
+    "x11.XGetInputFocus",
+    "x11.XRRGet",
+    "wl.roundtrip",
+    "posix.poll",
+    "linux.inotify_read",
+    "linux.evdev_read"
+};
+
+// The default allocator functions
+//
+static void* defaultAllocate(size_t size, void* user)
+{
+    return malloc(size);
+}
+
+static void defaultDeallocate(void* block, void* user)
+{
+    free(block);
+}
+
+static void* defaultReallocate(void* block, size_t size, void* user)
+{
+    return realloc(block, size);
+}
+
 // Terminate the library
 //
 static void terminate(void)
@@ -65,11 +112,13 @@ static void terminate(void)
 
     memset(&_glfw.callbacks, 0, sizeof(_glfw.callbacks));
 
+    _glfwTerminateRecording();
+
     while (_glfw.windowListHead)
         glfwDestroyWindow((GLFWwindow*) _glfw.windowListHead);
 
     while (_glfw.cursorListHead)
-        glfwDestroyCursor((GLFWcursor*) _glfw.cursorListHead);
+        _glfwDestroyCursor(_glfw.cursorListHead);
 
     for (i = 0;  i < _glfw.monitorCount;  i++)
     {
@@ -79,34 +128,319 @@ static void terminate(void)
         _glfwFreeMonitor(monitor);
     }
 
-    free(_glfw.monitors);
+    _glfw_free(_glfw.monitors);
     _glfw.monitors = NULL;
     _glfw.monitorCount = 0;
 
-    free(_glfw.mappings);
+    _glfw_free(_glfw.mappings);
     _glfw.mappings = NULL;
     _glfw.mappingCount = 0;
 
+    if (_glfw.joysticksInitialized)
+        _glfwPlatformTerminateJoysticks();
+
     _glfwTerminateVulkan();
     _glfwPlatformTerminate();
 
     _glfw.initialized = GLFW_FALSE;
 
+#if !defined(_GLFW_THREAD_LOCAL)
     while (_glfw.errorListHead)
     {
         _GLFWerror* error = _glfw.errorListHead;
         _glfw.errorListHead = error->next;
-        free(error);
+        _glfw.allocator.deallocate(error, _glfw.allocator.user);
     }
 
-    _glfwPlatformDestroyTls(&_glfw.contextSlot);
     _glfwPlatformDestroyTls(&_glfw.errorSlot);
     _glfwPlatformDestroyMutex(&_glfw.errorLock);
+#endif
+    _glfwPlatformDestroyTls(&_glfw.contextSlot);
+    _glfwPlatformDestroyMutex(&_glfw.vk.lock);
 
     memset(&_glfw, 0, sizeof(_glfw));
 }
 
 
+// Returns the error record of the calling thread
+//
+static _GLFWerror* getErrorRecord(void)
+{
+#if defined(_GLFW_THREAD_LOCAL)
+    return &_glfwThreadError;
+#else
+    _GLFWerror* error;
+
+    if (!_glfw.initialized)
+        return &_glfwMainThreadError;
+
+    error = _glfwPlatformGetTls(&_glfw.errorSlot);
+    if (!error)
+    {
+        // Allocation failures cannot be reported without an error record
+        error = _glfw.allocator.allocate(sizeof(_GLFWerror), _glfw.allocator.user);
+        if (!error)
+            return NULL;
+
+        memset(error, 0, sizeof(_GLFWerror));
+
+        _glfwPlatformSetTls(&_glfw.errorSlot, error);
+        _glfwPlatformLockMutex(&_glfw.errorLock);
+        error->next = _glfw.errorListHead;
+        _glfw.errorListHead = error;
+        _glfwPlatformUnlockMutex(&_glfw.errorLock);
+    }
+
+    return error;
+#endif
+}
+
+// Returns the description of errors reported without a format string
+//
+static const char* getDefaultDescription(int code)
+{
+    switch (code)
+    {
+        case GLFW_NOT_INITIALIZED:
+            return "The GLFW library is not initialized";
+        case GLFW_NO_CURRENT_CONTEXT:
+            return "There is no current context";
+        case GLFW_INVALID_ENUM:
+            return "Invalid argument for enum parameter";
+        case GLFW_INVALID_VALUE:
+            return "Invalid value for parameter";
+        case GLFW_OUT_OF_MEMORY:
+            return "Out of memory";
+        case GLFW_API_UNAVAILABLE:
+            return "The requested API is unavailable";
+        case GLFW_VERSION_UNAVAILABLE:
+            return "The requested API version is unavailable";
+        case GLFW_PLATFORM_ERROR:
+            return "A platform-specific error occurred";
+        case GLFW_FORMAT_UNAVAILABLE:
+            return "The requested format is unavailable";
+        case GLFW_NO_WINDOW_CONTEXT:
+            return "The specified window has no context";
+        default:
+            return "ERROR: UNKNOWN GLFW ERROR";
+    }
+}
+
+// Stores the arguments of an error description for formatting it later
+// Returns GLFW_FALSE if the format string uses anything not handled here, in
+// which case the description must be formatted right away
+//
+static GLFWbool storeErrorArgs(_GLFWerror* error, const char* format, va_list vl)
+{
+    const char* c;
+
+    error->argCount = 0;
+    error->stringSize = 0;
+
+    for (c = format;  *c;  c++)
+    {
+        const char* start;
+        _GLFWerrorarg* arg;
+        int type = _GLFW_ERROR_ARG_INT;
+
+        if (*c != '%')
+            continue;
+
+        start = c++;
+        if (*c == '%')
+            continue;
+
+        if (error->argCount == _GLFW_ERROR_ARG_COUNT)
+            return GLFW_FALSE;
+
+        arg = error->args + error->argCount;
+
+        c += strspn(c, "-+ #0123456789.");
+
+        if (c[0] == 'h')
+            c += (c[1] == 'h') ? 2 : 1;
+        else if (c[0] == 'l' && c[1] == 'l')
+        {
+            type = _GLFW_ERROR_ARG_LONG_LONG;
+            c += 2;
+        }
+        else if (c[0] == 'l')
+        {
+            type = _GLFW_ERROR_ARG_LONG;
+            c++;
+        }
+        else if (c[0] == 'z')
+        {
+            type = _GLFW_ERROR_ARG_SIZE;
+            c++;
+        }
+
+        // The conversion specification is copied when formatting
+        if (c - start > 14)
+            return GLFW_FALSE;
+
+        switch (*c)
+        {
+            case 'd':
+            case 'i':
+            case 'u':
+            case 'o':
+            case 'x':
+            case 'X':
+            case 'c':
+            {
+                if (type == _GLFW_ERROR_ARG_LONG_LONG)
+                    arg->value.ll = va_arg(vl, long long);
+                else if (type == _GLFW_ERROR_ARG_LONG)
+                    arg->value.l = va_arg(vl, long);
+                else if (type == _GLFW_ERROR_ARG_SIZE)
+                    arg->value.z = va_arg(vl, size_t);
+                else
+                    arg->value.i = va_arg(vl, int);
+                break;
+            }
+
+            case 'f':
+            case 'F':
+            case 'e':
+            case 'E':
+            case 'g':
+            case 'G':
+            {
+                if (type != _GLFW_ERROR_ARG_INT)
+                    return GLFW_FALSE;
+
+                type = _GLFW_ERROR_ARG_DOUBLE;
+                arg->value.d = va_arg(vl, double);
+                break;
+            }
+
+            case 'p':
+            {
+                if (type != _GLFW_ERROR_ARG_INT)
+                    return GLFW_FALSE;
+
+                type = _GLFW_ERROR_ARG_POINTER;
+                arg->value.p = va_arg(vl, const void*);
+                break;
+            }
+
+            case 's':
+            {
+                size_t size;
+                const char* string;
+
+                if (type != _GLFW_ERROR_ARG_INT)
+                    return GLFW_FALSE;
+
+                string = va_arg(vl, const char*);
+                if (!string)
+                    return GLFW_FALSE;
+
+                // The string may not outlive this call so it is copied
+                size = strlen(string) + 1;
+                if (size > sizeof(error->strings) - error->stringSize)
+                    return GLFW_FALSE;
+
+                memcpy(error->strings + error->stringSize, string, size);
+                type = _GLFW_ERROR_ARG_STRING;
+                arg->value.s = error->strings + error->stringSize;
+                error->stringSize += size;
+                break;
+            }
+
+            default:
+                return GLFW_FALSE;
+        }
+
+        arg->type = type;
+        error->argCount++;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Returns the description of the error, formatting it if necessary
+//
+static const char* getErrorDescription(_GLFWerror* error)
+{
+    const char* c;
+    char* target = error->description;
+    size_t remaining = sizeof(error->description);
+    int index = 0;
+
+    if (!error->format)
+        return error->message;
+
+    for (c = error->format;  *c && remaining > 1;  )
+    {
+        char spec[16];
+        size_t length;
+        int count;
+        const _GLFWerrorarg* arg;
+
+        if (c[0] != '%' || c[1] == '%')
+        {
+            *target++ = *c;
+            c += (c[0] == '%') ? 2 : 1;
+            remaining--;
+            continue;
+        }
+
+        length = strcspn(c + 1, "diuoxXcfFeEgGps") + 2;
+        memcpy(spec, c, length);
+        spec[length] = '\0';
+        c += length;
+
+        arg = error->args + index++;
+
+        switch (arg->type)
+        {
+            case _GLFW_ERROR_ARG_LONG:
+                count = snprintf(target, remaining, spec, arg->value.l);
+                break;
+            case _GLFW_ERROR_ARG_LONG_LONG:
+                count = snprintf(target, remaining, spec, arg->value.ll);
+                break;
+            case _GLFW_ERROR_ARG_SIZE:
+                count = snprintf(target, remaining, spec, arg->value.z);
+                break;
+            case _GLFW_ERROR_ARG_DOUBLE:
+                count = snprintf(target, remaining, spec, arg->value.d);
+                break;
+            case _GLFW_ERROR_ARG_POINTER:
+                count = snprintf(target, remaining, spec, arg->value.p);
+                break;
+            case _GLFW_ERROR_ARG_STRING:
+                count = snprintf(target, remaining, spec, arg->value.s);
+                break;
+            default:
+                count = snprintf(target, remaining, spec, arg->value.i);
+                break;
+        }
+
+        if (count < 0)
+            break;
+
+        if ((size_t) count >= remaining)
+        {
+            target += remaining - 1;
+            remaining = 1;
+            break;
+        }
+
+        target += count;
+        remaining -= count;
+    }
+
+    *target = '\0';
+
+    error->format = NULL;
+    error->message = error->description;
+    return error->message;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
@@ -114,11 +448,147 @@ static void terminate(void)
 char* _glfw_strdup(const char* source)
 {
     const size_t length = strlen(source);
-    char* result = calloc(length + 1, 1);
-    strcpy(result, source);
+    char* result = _glfw_calloc(length + 1, 1);
+    if (result)
+        strcpy(result, source);
     return result;
 }
 
+// Returns the start time of an initialization phase
+//
+uint64_t _glfwBeginInitPhase(void)
+{
+    return _glfwPlatformGetTimerValue();
+}
+
+// Adds a finished initialization phase to the startup trace
+//
+void _glfwEndInitPhase(const char* name, uint64_t start)
+{
+    GLFWinitphase* phase;
+
+    if (_glfw.initPhaseCount == _GLFW_INIT_PHASE_COUNT)
+        return;
+
+    phase = _glfw.initPhases + _glfw.initPhaseCount++;
+    phase->name = name;
+    phase->duration = (double) (_glfwPlatformGetTimerValue() - start) /
+        _glfwPlatformGetTimerFrequency();
+}
+
+// Allocates zero-initialized memory with the allocator of the library
+//
+void* _glfw_calloc(size_t count, size_t size)
+{
+    if (count && size)
+    {
+        void* block;
+
+        if (count > SIZE_MAX / size)
+        {
+            _glfwInputError(GLFW_INVALID_VALUE, "Allocation size overflow");
+            return NULL;
+        }
+
+        block = _glfw.allocator.allocate(count * size, _glfw.allocator.user);
+        if (block)
+            return memset(block, 0, count * size);
+        else
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return NULL;
+        }
+    }
+    else
+        return NULL;
+}
+
+// Resizes memory allocated by _glfw_calloc or _glfw_realloc
+//
+void* _glfw_realloc(void* block, size_t size)
+{
+    if (block && size)
+    {
+        void* resized = _glfw.allocator.reallocate(block, size, _glfw.allocator.user);
+        if (resized)
+            return resized;
+        else
+        {
+            _glfwInputError(GLFW_OUT_OF_MEMORY, NULL);
+            return NULL;
+        }
+    }
+    else if (block)
+    {
+        _glfw_free(block);
+        return NULL;
+    }
+    else
+        return _glfw_calloc(1, size);
+}
+
+// Frees memory allocated by _glfw_calloc or _glfw_realloc
+//
+void _glfw_free(void* block)
+{
+    if (block)
+        _glfw.allocator.deallocate(block, _glfw.allocator.user);
+}
+
+// Encode a Unicode code point to a UTF-8 stream
+// Based on cutef8 by Jeff Bezanson (Public Domain)
+//
+size_t _glfwEncodeUTF8(char* s, unsigned int ch)
+{
+    size_t count = 0;
+
+    if (ch < 0x80)
+        s[count++] = (char) ch;
+    else if (ch < 0x800)
+    {
+        s[count++] = (ch >> 6) | 0xc0;
+        s[count++] = (ch & 0x3f) | 0x80;
+    }
+    else if (ch < 0x10000)
+    {
+        s[count++] = (ch >> 12) | 0xe0;
+        s[count++] = ((ch >> 6) & 0x3f) | 0x80;
+        s[count++] = (ch & 0x3f) | 0x80;
+    }
+    else if (ch < 0x110000)
+    {
+        s[count++] = (ch >> 18) | 0xf0;
+        s[count++] = ((ch >> 12) & 0x3f) | 0x80;
+        s[count++] = ((ch >> 6) & 0x3f) | 0x80;
+        s[count++] = (ch & 0x3f) | 0x80;
+    }
+
+    return count;
+}
+
+// Decode a Unicode code point from a UTF-8 stream
+// Based on cutef8 by Jeff Bezanson (Public Domain)
+//
+unsigned int _glfwDecodeUTF8(const char** s)
+{
+    unsigned int ch = 0, count = 0;
+    static const unsigned int offsets[] =
+    {
+        0x00000000u, 0x00003080u, 0x000e2080u,
+        0x03c82080u, 0xfa082080u, 0x82082080u
+    };
+
+    do
+    {
+        ch = (ch << 6) + (unsigned char) **s;
+        (*s)++;
+        count++;
+    } while ((**s & 0xc0) == 0x80);
+
+    assert(count <= 6);
+    return ch - offsets[count - 1];
+}
+
 float _glfw_fminf(float a, float b)
 {
     if (a != a)
@@ -148,70 +618,57 @@ float _glfw_fmaxf(float a, float b)
 //////                         GLFW event API                       //////
 //////////////////////////////////////////////////////////////////////////
 
+// Notifies the trace callback of the beginning or end of an operation
+//
+void _glfwInputTrace(const char* name, int begin)
+{
+    // The callback may be removed by the main thread while another thread is
+    // tracing, so it is only read once
+    const GLFWtracefun callback = _glfwTraceCallback;
+    if (callback)
+        callback(name, begin);
+}
+
 // Notifies shared code of an error
 //
+// The format string must have static storage duration, as it is kept for
+// formatting the description later
+//
 void _glfwInputError(int code, const char* format, ...)
 {
-    _GLFWerror* error;
-    char description[_GLFW_MESSAGE_SIZE];
+    _GLFWerror* error = getErrorRecord();
+    if (!error)
+        return;
+
+    error->code = code;
+    error->format = NULL;
 
     if (format)
     {
         va_list vl;
+        GLFWbool stored;
 
         va_start(vl, format);
-        vsnprintf(description, sizeof(description), format, vl);
+        stored = storeErrorArgs(error, format, vl);
         va_end(vl);
 
-        description[sizeof(description) - 1] = '\0';
-    }
-    else
-    {
-        if (code == GLFW_NOT_INITIALIZED)
-            strcpy(description, "The GLFW library is not initialized");
-        else if (code == GLFW_NO_CURRENT_CONTEXT)
-            strcpy(description, "There is no current context");
-        else if (code == GLFW_INVALID_ENUM)
-            strcpy(description, "Invalid argument for enum parameter");
-        else if (code == GLFW_INVALID_VALUE)
-            strcpy(description, "Invalid value for parameter");
-        else if (code == GLFW_OUT_OF_MEMORY)
-            strcpy(description, "Out of memory");
-        else if (code == GLFW_API_UNAVAILABLE)
-            strcpy(description, "The requested API is unavailable");
-        else if (code == GLFW_VERSION_UNAVAILABLE)
-            strcpy(description, "The requested API version is unavailable");
-        else if (code == GLFW_PLATFORM_ERROR)
-            strcpy(description, "A platform-specific error occurred");
-        else if (code == GLFW_FORMAT_UNAVAILABLE)
-            strcpy(description, "The requested format is unavailable");
-        else if (code == GLFW_NO_WINDOW_CONTEXT)
-            strcpy(description, "The specified window has no context");
+        if (stored)
+            error->format = format;
         else
-            strcpy(description, "ERROR: UNKNOWN GLFW ERROR");
-    }
-
-    if (_glfw.initialized)
-    {
-        error = _glfwPlatformGetTls(&_glfw.errorSlot);
-        if (!error)
         {
-            error = calloc(1, sizeof(_GLFWerror));
-            _glfwPlatformSetTls(&_glfw.errorSlot, error);
-            _glfwPlatformLockMutex(&_glfw.errorLock);
-            error->next = _glfw.errorListHead;
-            _glfw.errorListHead = error;
-            _glfwPlatformUnlockMutex(&_glfw.errorLock);
+            va_start(vl, format);
+            vsnprintf(error->description, sizeof(error->description), format, vl);
+            va_end(vl);
+
+            error->description[sizeof(error->description) - 1] = '\0';
+            error->message = error->description;
         }
     }
     else
-        error = &_glfwMainThreadError;
-
-    error->code = code;
-    strcpy(error->description, description);
+        error->message = getDefaultDescription(code);
 
     if (_glfwErrorCallback)
-        _glfwErrorCallback(code, description);
+        _glfwErrorCallback(code, getErrorDescription(error));
 }
 
 
@@ -227,40 +684,57 @@ GLFWAPI int glfwInit(void)
     memset(&_glfw, 0, sizeof(_glfw));
     _glfw.hints.init = _glfwInitHints;
 
-    if (!_glfwPlatformInit())
+    _glfw.allocator = _glfwInitAllocator;
+    if (!_glfw.allocator.allocate)
     {
-        terminate();
-        return GLFW_FALSE;
+        _glfw.allocator.allocate   = defaultAllocate;
+        _glfw.allocator.reallocate = defaultReallocate;
+        _glfw.allocator.deallocate = defaultDeallocate;
+    }
+
+    _glfwPlatformInitTimer();
+
+    {
+        const uint64_t start = _glfwBeginInitPhase();
+
+        if (!_glfwPlatformInit())
+        {
+            terminate();
+            return GLFW_FALSE;
+        }
+
+        _glfwEndInitPhase("platform", start);
     }
 
+#if !defined(_GLFW_THREAD_LOCAL)
     if (!_glfwPlatformCreateMutex(&_glfw.errorLock) ||
-        !_glfwPlatformCreateTls(&_glfw.errorSlot) ||
-        !_glfwPlatformCreateTls(&_glfw.contextSlot))
+        !_glfwPlatformCreateTls(&_glfw.errorSlot))
     {
         terminate();
         return GLFW_FALSE;
     }
 
     _glfwPlatformSetTls(&_glfw.errorSlot, &_glfwMainThreadError);
+#endif
 
-    _glfw.initialized = GLFW_TRUE;
-    _glfw.timer.offset = _glfwPlatformGetTimerValue();
+    if (!_glfwPlatformCreateTls(&_glfw.contextSlot) ||
+        !_glfwPlatformCreateMutex(&_glfw.vk.lock))
+    {
+        terminate();
+        return GLFW_FALSE;
+    }
 
-    glfwDefaultWindowHints();
+    _glfw.initialized = GLFW_TRUE;
+    _glfw.timer.offset = _glfwGetTimerValue();
 
     {
-        int i;
+        unsigned int i;
 
-        for (i = 0;  _glfwDefaultMappings[i];  i++)
-        {
-            if (!glfwUpdateGamepadMappings(_glfwDefaultMappings[i]))
-            {
-                terminate();
-                return GLFW_FALSE;
-            }
-        }
+        for (i = 0;  i < _GLFW_USER_EVENT_CAPACITY;  i++)
+            _glfw.userEvents.slots[i].sequence = i;
     }
 
+    glfwDefaultWindowHints();
     return GLFW_TRUE;
 }
 
@@ -279,18 +753,81 @@ GLFWAPI void glfwInitHint(int hint, int value)
         case GLFW_JOYSTICK_HAT_BUTTONS:
             _glfwInitHints.hatButtons = value;
             return;
+        case GLFW_VIRTUAL_CLOCK:
+            _glfwInitHints.virtualClock = value;
+            return;
+        case GLFW_TSC_TIMER:
+            _glfwInitHints.tscTimer = value;
+            return;
+        case GLFW_VULKAN_CACHE:
+            _glfwInitHints.vulkanCache = value;
+            return;
         case GLFW_COCOA_CHDIR_RESOURCES:
             _glfwInitHints.ns.chdir = value;
             return;
         case GLFW_COCOA_MENUBAR:
             _glfwInitHints.ns.menubar = value;
             return;
+        case GLFW_X11_ASYNC_WINDOWS:
+            _glfwInitHints.x11.asyncWindows = value;
+            return;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM,
                     "Invalid init hint 0x%08X", hint);
 }
 
+GLFWAPI void glfwInitAllocator(const GLFWallocator* allocator)
+{
+    if (allocator)
+    {
+        if (allocator->allocate && allocator->reallocate && allocator->deallocate)
+            _glfwInitAllocator = *allocator;
+        else
+            _glfwInputError(GLFW_INVALID_VALUE, "Missing function in allocator");
+    }
+    else
+        memset(&_glfwInitAllocator, 0, sizeof(GLFWallocator));
+}
+
+GLFWAPI const GLFWinitphase* glfwGetInitPhases(int* count)
+{
+    assert(count != NULL);
+
+    *count = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    *count = _glfw.initPhaseCount;
+    return _glfw.initPhases;
+}
+
+GLFWAPI const GLFWcounter* glfwGetInternalCounters(int* count)
+{
+    int i;
+
+    assert(count != NULL);
+
+    *count = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    for (i = 0;  i < _GLFW_COUNTER_COUNT;  i++)
+    {
+        _glfw.counterValues[i].name = counterNames[i];
+        _glfw.counterValues[i].value = _glfw.counters[i];
+    }
+
+    *count = _GLFW_COUNTER_COUNT;
+    return _glfw.counterValues;
+}
+
+GLFWAPI void glfwResetInternalCounters(void)
+{
+    _GLFW_REQUIRE_INIT();
+    memset(_glfw.counters, 0, sizeof(_glfw.counters));
+}
+
 GLFWAPI void glfwGetVersion(int* major, int* minor, int* rev)
 {
     if (major != NULL)
@@ -314,17 +851,21 @@ GLFWAPI int glfwGetError(const char** description)
     if (description)
         *description = NULL;
 
+#if defined(_GLFW_THREAD_LOCAL)
+    error = &_glfwThreadError;
+#else
     if (_glfw.initialized)
         error = _glfwPlatformGetTls(&_glfw.errorSlot);
     else
         error = &_glfwMainThreadError;
+#endif
 
     if (error)
     {
         code = error->code;
         error->code = GLFW_NO_ERROR;
         if (description && code)
-            *description = error->description;
+            *description = getErrorDescription(error);
     }
 
     return code;
@@ -336,3 +877,9 @@ GLFWAPI GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun cbfun)
     return cbfun;
 }
 
+GLFWAPI GLFWtracefun glfwSetTraceCallback(GLFWtracefun cbfun)
+{
+    _GLFW_SWAP_POINTERS(_glfwTraceCallback, cbfun);
+    return cbfun;
+}
+
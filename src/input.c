@@ -26,6 +26,7 @@
 //========================================================================
 
 #include "internal.h"
+#include "mappings.h"
 
 #include <assert.h>
 #include <float.h>
@@ -250,6 +251,239 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
 }
 
 
+// Adds or replaces the gamepad mappings in the specified string
+//
+static void addMappings(const char* string)
+{
+    const char* c = string;
+
+    while (*c)
+    {
+        if ((*c >= '0' && *c <= '9') ||
+            (*c >= 'a' && *c <= 'f') ||
+            (*c >= 'A' && *c <= 'F'))
+        {
+            char line[1024];
+
+            const size_t length = strcspn(c, "\r\n");
+            if (length < sizeof(line))
+            {
+                _GLFWmapping mapping = {{0}};
+
+                memcpy(line, c, length);
+                line[length] = '\0';
+
+                if (parseMapping(&mapping, line))
+                {
+                    _GLFWmapping* previous = findMapping(mapping.guid);
+                    if (previous)
+                        *previous = mapping;
+                    else
+                    {
+                        _glfw.mappingCount++;
+                        _glfw.mappings =
+                            _glfw_realloc(_glfw.mappings,
+                                    sizeof(_GLFWmapping) * _glfw.mappingCount);
+                        _glfw.mappings[_glfw.mappingCount - 1] = mapping;
+                    }
+                }
+            }
+
+            c += length;
+        }
+        else
+        {
+            c += strcspn(c, "\r\n");
+            c += strspn(c, "\r\n");
+        }
+    }
+}
+
+// Parses the built-in gamepad mappings on first use
+//
+static GLFWbool initMappings(void)
+{
+    if (!_glfw.mappingsInitialized)
+    {
+        int i;
+        const uint64_t start = _glfwBeginInitPhase();
+
+        for (i = 0;  _glfwDefaultMappings[i];  i++)
+            addMappings(_glfwDefaultMappings[i]);
+
+        _glfwEndInitPhase("mappings", start);
+        _glfw.mappingsInitialized = GLFW_TRUE;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Polls the state of the specified joystick as a traced operation
+//
+static GLFWbool pollJoystick(_GLFWjoystick* js, int mode)
+{
+    GLFWbool result;
+
+    _GLFW_TRACE_BEGIN("joystick.poll");
+    result = _glfwPlatformPollJoystick(js, mode);
+    _GLFW_TRACE_END("joystick.poll");
+
+    return result;
+}
+
+// Initializes the platform joystick API on first use
+//
+static GLFWbool initJoysticks(void)
+{
+    if (!_glfw.joysticksInitialized)
+    {
+        uint64_t start;
+
+        if (!initMappings())
+            return GLFW_FALSE;
+
+        start = _glfwBeginInitPhase();
+        _GLFW_TRACE_BEGIN("joystick.init");
+
+        if (!_glfwPlatformInitJoysticks())
+        {
+            _GLFW_TRACE_END("joystick.init");
+            _glfwPlatformTerminateJoysticks();
+            return GLFW_FALSE;
+        }
+
+        _GLFW_TRACE_END("joystick.init");
+        _glfwEndInitPhase("joysticks", start);
+        _glfw.joysticksInitialized = GLFW_TRUE;
+    }
+
+    return GLFW_TRUE;
+}
+
+
+// Notifies the per-codepoint character callbacks
+//
+static void inputCodepoint(_GLFWwindow* window, unsigned int codepoint, int mods, GLFWbool plain)
+{
+    if (_glfw.recorder)
+        _glfwRecordEvent(_GLFW_RECORD_CHAR, window, (int) codepoint, mods, plain, 0);
+
+    if (codepoint < 32 || (codepoint > 126 && codepoint < 160))
+        return;
+
+    if (!window->lockKeyMods)
+        mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
+
+    if (window->callbacks.charmods)
+        window->callbacks.charmods((GLFWwindow*) window, codepoint, mods);
+
+    if (plain)
+    {
+        if (window->callbacks.character)
+            window->callbacks.character((GLFWwindow*) window, codepoint);
+    }
+}
+
+
+// Hashes the specified cursor image and hotspot
+// The hash is only used to skip most comparisons, the pixels are always compared
+//
+static uint64_t hashCursorImage(const GLFWimage* image, int xhot, int yhot)
+{
+    const size_t size = (size_t) image->width * image->height * 4;
+    const uint64_t prime = 0x100000001b3u;
+    uint64_t hash = 0xcbf29ce484222325u;
+    size_t i;
+
+    hash = (hash ^ (uint32_t) image->width) * prime;
+    hash = (hash ^ (uint32_t) image->height) * prime;
+    hash = (hash ^ (uint32_t) xhot) * prime;
+    hash = (hash ^ (uint32_t) yhot) * prime;
+
+    // Mix in whole words where possible as cursor images can be large
+    for (i = 0;  i + 8 <= size;  i += 8)
+    {
+        uint64_t word;
+        memcpy(&word, image->pixels + i, sizeof(word));
+        hash = (hash ^ word) * prime;
+        hash ^= hash >> 32;
+    }
+
+    for (;  i < size;  i++)
+        hash = (hash ^ image->pixels[i]) * prime;
+
+    return hash;
+}
+
+// Returns an existing cursor matching the specified key, if any
+//
+static _GLFWcursor* findCursor(uint64_t hash, int shape,
+                               const GLFWimage* image, int xhot, int yhot)
+{
+    _GLFWcursor* cursor;
+
+    for (cursor = _glfw.cursorListHead;  cursor;  cursor = cursor->next)
+    {
+        if (cursor->hash != hash || cursor->shape != shape)
+            continue;
+
+        if (shape)
+            return cursor;
+
+        if (cursor->width == image->width &&
+            cursor->height == image->height &&
+            cursor->xhot == xhot &&
+            cursor->yhot == yhot &&
+            memcmp(cursor->pixels, image->pixels,
+                   (size_t) image->width * image->height * 4) == 0)
+        {
+            return cursor;
+        }
+    }
+
+    return NULL;
+}
+
+// Moves the specified cursor to the head of the cursor list
+// This keeps the cached cursors ordered from most to least recently released
+//
+static void moveCursorToHead(_GLFWcursor* cursor)
+{
+    _GLFWcursor** prev = &_glfw.cursorListHead;
+
+    while (*prev != cursor)
+        prev = &((*prev)->next);
+
+    *prev = cursor->next;
+    cursor->next = _glfw.cursorListHead;
+    _glfw.cursorListHead = cursor;
+}
+
+// Adds a reference to an existing cursor, reviving it if it was cached
+//
+static _GLFWcursor* acquireCursor(_GLFWcursor* cursor)
+{
+    if (cursor->refCount == 0)
+        _glfw.cachedCursorCount--;
+
+    cursor->refCount++;
+    return cursor;
+}
+
+// Allocates a cursor object and links it into the cursor list
+//
+static _GLFWcursor* allocateCursor(uint64_t hash, int shape)
+{
+    _GLFWcursor* cursor = _glfw_calloc(1, sizeof(_GLFWcursor));
+    cursor->next = _glfw.cursorListHead;
+    cursor->refCount = 1;
+    cursor->hash = hash;
+    cursor->shape = shape;
+    _glfw.cursorListHead = cursor;
+    return cursor;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -258,6 +492,9 @@ static GLFWbool parseMapping(_GLFWmapping* mapping, const char* string)
 //
 void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int mods)
 {
+    if (_glfw.recorder)
+        _glfwRecordEvent(_GLFW_RECORD_KEY, window, key, scancode, action, mods);
+
     if (key >= 0 && key <= GLFW_KEY_LAST)
     {
         GLFWbool repeated = GLFW_FALSE;
@@ -289,19 +526,61 @@ void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int m
 //
 void _glfwInputChar(_GLFWwindow* window, unsigned int codepoint, int mods, GLFWbool plain)
 {
-    if (codepoint < 32 || (codepoint > 126 && codepoint < 160))
-        return;
+    if (plain && window->callbacks.text &&
+        !(codepoint < 32 || (codepoint > 126 && codepoint < 160)))
+    {
+        char text[5];
+        text[_glfwEncodeUTF8(text, codepoint)] = '\0';
+        window->callbacks.text((GLFWwindow*) window, text);
+    }
 
-    if (!window->lockKeyMods)
-        mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
+    inputCodepoint(window, codepoint, mods, plain);
+}
 
-    if (window->callbacks.charmods)
-        window->callbacks.charmods((GLFWwindow*) window, codepoint, mods);
+// Notifies shared code of a run of UTF-8 encoded text
+// The text must be null-terminated at the specified length and may be modified
+//
+void _glfwInputText(_GLFWwindow* window, char* text, size_t length, int mods, GLFWbool plain)
+{
+    if (plain && window->callbacks.text)
+    {
+        // Strip C0 and C1 control characters in place
+        // All other bytes, including continuation bytes, are copied unchanged
+        size_t i, count = 0;
 
-    if (plain)
+        for (i = 0;  i < length;  i++)
+        {
+            const unsigned char c = (unsigned char) text[i];
+
+            if (c < 32 || c == 127)
+                continue;
+
+            if (c == 0xc2 && i + 1 < length &&
+                (unsigned char) text[i + 1] >= 0x80 &&
+                (unsigned char) text[i + 1] < 0xa0)
+            {
+                i++;
+                continue;
+            }
+
+            text[count++] = text[i];
+        }
+
+        text[count] = '\0';
+        length = count;
+
+        if (length)
+            window->callbacks.text((GLFWwindow*) window, text);
+    }
+
+    // Decoding is only needed if someone consumes individual code points
+    if (_glfw.recorder ||
+        window->callbacks.charmods ||
+        (plain && window->callbacks.character))
     {
-        if (window->callbacks.character)
-            window->callbacks.character((GLFWwindow*) window, codepoint);
+        const char* c = text;
+        while (c < text + length)
+            inputCodepoint(window, _glfwDecodeUTF8(&c), mods, plain);
     }
 }
 
@@ -309,6 +588,9 @@ void _glfwInputChar(_GLFWwindow* window, unsigned int codepoint, int mods, GLFWb
 //
 void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset)
 {
+    if (_glfw.recorder)
+        _glfwRecordMotion(_GLFW_RECORD_SCROLL, window, xoffset, yoffset);
+
     if (window->callbacks.scroll)
         window->callbacks.scroll((GLFWwindow*) window, xoffset, yoffset);
 }
@@ -317,6 +599,9 @@ void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset)
 //
 void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
 {
+    if (_glfw.recorder)
+        _glfwRecordEvent(_GLFW_RECORD_MOUSE_BUTTON, window, button, action, mods, 0);
+
     if (button < 0 || button > GLFW_MOUSE_BUTTON_LAST)
         return;
 
@@ -337,6 +622,9 @@ void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
 //
 void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos)
 {
+    if (_glfw.recorder)
+        _glfwRecordMotion(_GLFW_RECORD_CURSOR_POS, window, xpos, ypos);
+
     if (window->virtualCursorPosX == xpos && window->virtualCursorPosY == ypos)
         return;
 
@@ -351,6 +639,9 @@ void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos)
 //
 void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered)
 {
+    if (_glfw.recorder)
+        _glfwRecordEvent(_GLFW_RECORD_CURSOR_ENTER, window, entered, 0, 0, 0);
+
     if (window->callbacks.cursorEnter)
         window->callbacks.cursorEnter((GLFWwindow*) window, entered);
 }
@@ -359,8 +650,25 @@ void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered)
 //
 void _glfwInputDrop(_GLFWwindow* window, int count, const char** paths)
 {
+    if (_glfw.recorder)
+        _glfwRecordDrop(window, count, paths);
+
     if (window->callbacks.drop)
         window->callbacks.drop((GLFWwindow*) window, count, paths);
+
+    if (window->callbacks.dropStream)
+        window->callbacks.dropStream((GLFWwindow*) window, count, paths, GLFW_TRUE);
+}
+
+// Notifies shared code of a batch of files or directories dropped on a window
+// This is only used while no file drop callback is set and input is not
+// recorded, as those need the whole list to be passed to _glfwInputDrop
+//
+void _glfwInputDropStream(_GLFWwindow* window,
+                          int count, const char** paths, GLFWbool last)
+{
+    if (window->callbacks.dropStream)
+        window->callbacks.dropStream((GLFWwindow*) window, count, paths, last);
 }
 
 // Notifies shared code of a joystick connection or disconnection
@@ -429,9 +737,9 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
     js = _glfw.joysticks + jid;
     js->present     = GLFW_TRUE;
     js->name        = _glfw_strdup(name);
-    js->axes        = calloc(axisCount, sizeof(float));
-    js->buttons     = calloc(buttonCount + hatCount * 4, 1);
-    js->hats        = calloc(hatCount, 1);
+    js->axes        = _glfw_calloc(axisCount, sizeof(float));
+    js->buttons     = _glfw_calloc(buttonCount + hatCount * 4, 1);
+    js->hats        = _glfw_calloc(hatCount, 1);
     js->axisCount   = axisCount;
     js->buttonCount = buttonCount;
     js->hatCount    = hatCount;
@@ -446,10 +754,10 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
 //
 void _glfwFreeJoystick(_GLFWjoystick* js)
 {
-    free(js->name);
-    free(js->axes);
-    free(js->buttons);
-    free(js->hats);
+    _glfw_free(js->name);
+    _glfw_free(js->axes);
+    _glfw_free(js->buttons);
+    _glfw_free(js->hats);
     memset(js, 0, sizeof(_GLFWjoystick));
 }
 
@@ -463,6 +771,65 @@ void _glfwCenterCursorInContentArea(_GLFWwindow* window)
     _glfwPlatformSetCursorPos(window, width / 2.0, height / 2.0);
 }
 
+// Returns the current value of the virtual or platform timer
+//
+uint64_t _glfwGetTimerValue(void)
+{
+    if (_glfw.hints.init.virtualClock)
+        return _glfw.timer.virtualValue;
+
+    return _glfwPlatformGetTimerValue();
+}
+
+// Returns the frequency of the virtual or platform timer
+//
+uint64_t _glfwGetTimerFrequency(void)
+{
+    if (_glfw.hints.init.virtualClock)
+        return 1000000000;
+
+    return _glfwPlatformGetTimerFrequency();
+}
+
+// Advances the virtual clock by the specified number of timer units
+//
+void _glfwAdvanceTimer(uint64_t delta)
+{
+    _glfw.timer.virtualValue += delta;
+}
+
+
+// Destroys the specified cursor regardless of its reference count
+//
+void _glfwDestroyCursor(_GLFWcursor* cursor)
+{
+    _GLFWwindow* window;
+
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        if (window->cursor == cursor)
+            glfwSetCursor((GLFWwindow*) window, NULL);
+    }
+
+    if (cursor->refCount == 0)
+        _glfw.cachedCursorCount--;
+
+    _glfwPlatformDestroyCursor(cursor);
+
+    // Unlink cursor from global linked list
+    {
+        _GLFWcursor** prev = &_glfw.cursorListHead;
+
+        while (*prev != cursor)
+            prev = &((*prev)->next);
+
+        *prev = cursor->next;
+    }
+
+    _glfw_free(cursor->pixels);
+    _glfw_free(cursor);
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                        GLFW public API                       //////
@@ -728,21 +1095,35 @@ GLFWAPI void glfwSetCursorPos(GLFWwindow* handle, double xpos, double ypos)
 GLFWAPI GLFWcursor* glfwCreateCursor(const GLFWimage* image, int xhot, int yhot)
 {
     _GLFWcursor* cursor;
+    uint64_t hash;
+    size_t size;
 
     assert(image != NULL);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
-    cursor = calloc(1, sizeof(_GLFWcursor));
-    cursor->next = _glfw.cursorListHead;
-    _glfw.cursorListHead = cursor;
+    hash = hashCursorImage(image, xhot, yhot);
+
+    cursor = findCursor(hash, 0, image, xhot, yhot);
+    if (cursor)
+        return (GLFWcursor*) acquireCursor(cursor);
+
+    cursor = allocateCursor(hash, 0);
 
     if (!_glfwPlatformCreateCursor(cursor, image, xhot, yhot))
     {
-        glfwDestroyCursor((GLFWcursor*) cursor);
+        _glfwDestroyCursor(cursor);
         return NULL;
     }
 
+    size = (size_t) image->width * image->height * 4;
+    cursor->width = image->width;
+    cursor->height = image->height;
+    cursor->xhot = xhot;
+    cursor->yhot = yhot;
+    cursor->pixels = _glfw_calloc(size, 1);
+    memcpy(cursor->pixels, image->pixels, size);
+
     return (GLFWcursor*) cursor;
 }
 
@@ -763,13 +1144,15 @@ GLFWAPI GLFWcursor* glfwCreateStandardCursor(int shape)
         return NULL;
     }
 
-    cursor = calloc(1, sizeof(_GLFWcursor));
-    cursor->next = _glfw.cursorListHead;
-    _glfw.cursorListHead = cursor;
+    cursor = findCursor(shape, shape, NULL, 0, 0);
+    if (cursor)
+        return (GLFWcursor*) acquireCursor(cursor);
+
+    cursor = allocateCursor(shape, shape);
 
     if (!_glfwPlatformCreateStandardCursor(cursor, shape))
     {
-        glfwDestroyCursor((GLFWcursor*) cursor);
+        _glfwDestroyCursor(cursor);
         return NULL;
     }
 
@@ -785,6 +1168,9 @@ GLFWAPI void glfwDestroyCursor(GLFWcursor* handle)
     if (cursor == NULL)
         return;
 
+    if (--cursor->refCount > 0)
+        return;
+
     // Make sure the cursor is not being used by any window
     {
         _GLFWwindow* window;
@@ -796,19 +1182,22 @@ GLFWAPI void glfwDestroyCursor(GLFWcursor* handle)
         }
     }
 
-    _glfwPlatformDestroyCursor(cursor);
+    // Keep the native cursor around in case the same cursor is created again
+    moveCursorToHead(cursor);
+    _glfw.cachedCursorCount++;
 
-    // Unlink cursor from global linked list
+    if (_glfw.cachedCursorCount > _GLFW_CURSOR_CACHE_SIZE)
     {
-        _GLFWcursor** prev = &_glfw.cursorListHead;
+        _GLFWcursor* oldest = NULL;
 
-        while (*prev != cursor)
-            prev = &((*prev)->next);
+        for (cursor = _glfw.cursorListHead;  cursor;  cursor = cursor->next)
+        {
+            if (cursor->refCount == 0)
+                oldest = cursor;
+        }
 
-        *prev = cursor->next;
+        _glfwDestroyCursor(oldest);
     }
-
-    free(cursor);
 }
 
 GLFWAPI void glfwSetCursor(GLFWwindow* windowHandle, GLFWcursor* cursorHandle)
@@ -854,6 +1243,16 @@ GLFWAPI GLFWcharmodsfun glfwSetCharModsCallback(GLFWwindow* handle, GLFWcharmods
     return cbfun;
 }
 
+GLFWAPI GLFWtextfun glfwSetTextCallback(GLFWwindow* handle, GLFWtextfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(window->callbacks.text, cbfun);
+    return cbfun;
+}
+
 GLFWAPI GLFWmousebuttonfun glfwSetMouseButtonCallback(GLFWwindow* handle,
                                                       GLFWmousebuttonfun cbfun)
 {
@@ -908,6 +1307,17 @@ GLFWAPI GLFWdropfun glfwSetDropCallback(GLFWwindow* handle, GLFWdropfun cbfun)
     return cbfun;
 }
 
+GLFWAPI GLFWdropstreamfun glfwSetDropStreamCallback(GLFWwindow* handle,
+                                                    GLFWdropstreamfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(window->callbacks.dropStream, cbfun);
+    return cbfun;
+}
+
 GLFWAPI int glfwJoystickPresent(int jid)
 {
     _GLFWjoystick* js;
@@ -923,11 +1333,14 @@ GLFWAPI int glfwJoystickPresent(int jid)
         return GLFW_FALSE;
     }
 
+    if (!initJoysticks())
+        return GLFW_FALSE;
+
     js = _glfw.joysticks + jid;
     if (!js->present)
         return GLFW_FALSE;
 
-    return _glfwPlatformPollJoystick(js, _GLFW_POLL_PRESENCE);
+    return pollJoystick(js, _GLFW_POLL_PRESENCE);
 }
 
 GLFWAPI const float* glfwGetJoystickAxes(int jid, int* count)
@@ -948,11 +1361,14 @@ GLFWAPI const float* glfwGetJoystickAxes(int jid, int* count)
         return NULL;
     }
 
+    if (!initJoysticks())
+        return NULL;
+
     js = _glfw.joysticks + jid;
     if (!js->present)
         return NULL;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_AXES))
+    if (!pollJoystick(js, _GLFW_POLL_AXES))
         return NULL;
 
     *count = js->axisCount;
@@ -977,11 +1393,14 @@ GLFWAPI const unsigned char* glfwGetJoystickButtons(int jid, int* count)
         return NULL;
     }
 
+    if (!initJoysticks())
+        return NULL;
+
     js = _glfw.joysticks + jid;
     if (!js->present)
         return NULL;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_BUTTONS))
+    if (!pollJoystick(js, _GLFW_POLL_BUTTONS))
         return NULL;
 
     if (_glfw.hints.init.hatButtons)
@@ -1010,11 +1429,14 @@ GLFWAPI const unsigned char* glfwGetJoystickHats(int jid, int* count)
         return NULL;
     }
 
+    if (!initJoysticks())
+        return NULL;
+
     js = _glfw.joysticks + jid;
     if (!js->present)
         return NULL;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_BUTTONS))
+    if (!pollJoystick(js, _GLFW_POLL_BUTTONS))
         return NULL;
 
     *count = js->hatCount;
@@ -1036,11 +1458,14 @@ GLFWAPI const char* glfwGetJoystickName(int jid)
         return NULL;
     }
 
+    if (!initJoysticks())
+        return NULL;
+
     js = _glfw.joysticks + jid;
     if (!js->present)
         return NULL;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_PRESENCE))
+    if (!pollJoystick(js, _GLFW_POLL_PRESENCE))
         return NULL;
 
     return js->name;
@@ -1061,11 +1486,14 @@ GLFWAPI const char* glfwGetJoystickGUID(int jid)
         return NULL;
     }
 
+    if (!initJoysticks())
+        return NULL;
+
     js = _glfw.joysticks + jid;
     if (!js->present)
         return NULL;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_PRESENCE))
+    if (!pollJoystick(js, _GLFW_POLL_PRESENCE))
         return NULL;
 
     return js->guid;
@@ -1106,6 +1534,10 @@ GLFWAPI void* glfwGetJoystickUserPointer(int jid)
 GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun cbfun)
 {
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (!initJoysticks())
+        return NULL;
+
     _GLFW_SWAP_POINTERS(_glfw.callbacks.joystick, cbfun);
     return cbfun;
 }
@@ -1113,52 +1545,15 @@ GLFWAPI GLFWjoystickfun glfwSetJoystickCallback(GLFWjoystickfun cbfun)
 GLFWAPI int glfwUpdateGamepadMappings(const char* string)
 {
     int jid;
-    const char* c = string;
 
     assert(string != NULL);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
 
-    while (*c)
-    {
-        if ((*c >= '0' && *c <= '9') ||
-            (*c >= 'a' && *c <= 'f') ||
-            (*c >= 'A' && *c <= 'F'))
-        {
-            char line[1024];
-
-            const size_t length = strcspn(c, "\r\n");
-            if (length < sizeof(line))
-            {
-                _GLFWmapping mapping = {{0}};
-
-                memcpy(line, c, length);
-                line[length] = '\0';
-
-                if (parseMapping(&mapping, line))
-                {
-                    _GLFWmapping* previous = findMapping(mapping.guid);
-                    if (previous)
-                        *previous = mapping;
-                    else
-                    {
-                        _glfw.mappingCount++;
-                        _glfw.mappings =
-                            realloc(_glfw.mappings,
-                                    sizeof(_GLFWmapping) * _glfw.mappingCount);
-                        _glfw.mappings[_glfw.mappingCount - 1] = mapping;
-                    }
-                }
-            }
+    if (!initMappings())
+        return GLFW_FALSE;
 
-            c += length;
-        }
-        else
-        {
-            c += strcspn(c, "\r\n");
-            c += strspn(c, "\r\n");
-        }
-    }
+    addMappings(string);
 
     for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
     {
@@ -1185,11 +1580,14 @@ GLFWAPI int glfwJoystickIsGamepad(int jid)
         return GLFW_FALSE;
     }
 
+    if (!initJoysticks())
+        return GLFW_FALSE;
+
     js = _glfw.joysticks + jid;
     if (!js->present)
         return GLFW_FALSE;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_PRESENCE))
+    if (!pollJoystick(js, _GLFW_POLL_PRESENCE))
         return GLFW_FALSE;
 
     return js->mapping != NULL;
@@ -1210,11 +1608,14 @@ GLFWAPI const char* glfwGetGamepadName(int jid)
         return NULL;
     }
 
+    if (!initJoysticks())
+        return NULL;
+
     js = _glfw.joysticks + jid;
     if (!js->present)
         return NULL;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_PRESENCE))
+    if (!pollJoystick(js, _GLFW_POLL_PRESENCE))
         return NULL;
 
     if (!js->mapping)
@@ -1242,11 +1643,14 @@ GLFWAPI int glfwGetGamepadState(int jid, GLFWgamepadstate* state)
         return GLFW_FALSE;
     }
 
+    if (!initJoysticks())
+        return GLFW_FALSE;
+
     js = _glfw.joysticks + jid;
     if (!js->present)
         return GLFW_FALSE;
 
-    if (!_glfwPlatformPollJoystick(js, _GLFW_POLL_ALL))
+    if (!pollJoystick(js, _GLFW_POLL_ALL))
         return GLFW_FALSE;
 
     if (!js->mapping)
@@ -1311,20 +1715,30 @@ GLFWAPI void glfwSetClipboardString(GLFWwindow* handle, const char* string)
     assert(string != NULL);
 
     _GLFW_REQUIRE_INIT();
+
+    _GLFW_TRACE_BEGIN("clipboard.set");
     _glfwPlatformSetClipboardString(string);
+    _GLFW_TRACE_END("clipboard.set");
 }
 
 GLFWAPI const char* glfwGetClipboardString(GLFWwindow* handle)
 {
+    const char* string;
+
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
-    return _glfwPlatformGetClipboardString();
+
+    _GLFW_TRACE_BEGIN("clipboard.get");
+    string = _glfwPlatformGetClipboardString();
+    _GLFW_TRACE_END("clipboard.get");
+
+    return string;
 }
 
 GLFWAPI double glfwGetTime(void)
 {
     _GLFW_REQUIRE_INIT_OR_RETURN(0.0);
-    return (double) (_glfwPlatformGetTimerValue() - _glfw.timer.offset) /
-        _glfwPlatformGetTimerFrequency();
+    return (double) (_glfwGetTimerValue() - _glfw.timer.offset) /
+        _glfwGetTimerFrequency();
 }
 
 GLFWAPI void glfwSetTime(double time)
@@ -1337,18 +1751,32 @@ GLFWAPI void glfwSetTime(double time)
         return;
     }
 
-    _glfw.timer.offset = _glfwPlatformGetTimerValue() -
-        (uint64_t) (time * _glfwPlatformGetTimerFrequency());
+    _glfw.timer.offset = _glfwGetTimerValue() -
+        (uint64_t) (time * _glfwGetTimerFrequency());
 }
 
 GLFWAPI uint64_t glfwGetTimerValue(void)
 {
     _GLFW_REQUIRE_INIT_OR_RETURN(0);
-    return _glfwPlatformGetTimerValue();
+    return _glfwGetTimerValue();
 }
 
 GLFWAPI uint64_t glfwGetTimerFrequency(void)
 {
     _GLFW_REQUIRE_INIT_OR_RETURN(0);
-    return _glfwPlatformGetTimerFrequency();
+    return _glfwGetTimerFrequency();
+}
+
+GLFWAPI void glfwAdvanceTimerValue(uint64_t delta)
+{
+    _GLFW_REQUIRE_INIT();
+
+    if (!_glfw.hints.init.virtualClock)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "The virtual clock is not enabled");
+        return;
+    }
+
+    _glfwAdvanceTimer(delta);
 }
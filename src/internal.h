@@ -56,11 +56,77 @@
 #define _GLFW_POLL_BUTTONS      2
 #define _GLFW_POLL_ALL          (_GLFW_POLL_AXES | _GLFW_POLL_BUTTONS)
 
+#define _GLFW_COUNTER_X11_GET_WINDOW_PROPERTY   0
+#define _GLFW_COUNTER_X11_GET_WINDOW_ATTRIBUTES 1
+#define _GLFW_COUNTER_X11_QUERY_POINTER         2
+#define _GLFW_COUNTER_X11_TRANSLATE_COORDINATES 3
+#define _GLFW_COUNTER_X11_GET_INPUT_FOCUS       4
+#define _GLFW_COUNTER_X11_RANDR                 5
+#define _GLFW_COUNTER_WL_ROUNDTRIP              6
+#define _GLFW_COUNTER_POLL                      7
+#define _GLFW_COUNTER_INOTIFY_READ              8
+#define _GLFW_COUNTER_EVDEV_READ                9
+#define _GLFW_COUNTER_COUNT                     10
+
 #define _GLFW_MESSAGE_SIZE      1024
 
+// Maximum number of format arguments stored for deferred error formatting
+#define _GLFW_ERROR_ARG_COUNT   8
+
+// Argument types of deferred error descriptions
+#define _GLFW_ERROR_ARG_INT             0
+#define _GLFW_ERROR_ARG_LONG            1
+#define _GLFW_ERROR_ARG_LONG_LONG       2
+#define _GLFW_ERROR_ARG_SIZE            3
+#define _GLFW_ERROR_ARG_DOUBLE          4
+#define _GLFW_ERROR_ARG_POINTER         5
+#define _GLFW_ERROR_ARG_STRING          6
+
+// Per-thread error records are kept in native thread-local storage where the
+// compiler supports it, otherwise in a TLS slot of the platform
+#if defined(_MSC_VER)
+ #define _GLFW_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && \
+      !defined(__STDC_NO_THREADS__)
+ #define _GLFW_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__)
+ #define _GLFW_THREAD_LOCAL __thread
+#endif
+
+// Must be a power of two
+#define _GLFW_USER_EVENT_CAPACITY 1024
+
+// Maximum number of phases kept in the startup trace
+#define _GLFW_INIT_PHASE_COUNT  16
+
+// Maximum number of destroyed cursors kept for reuse
+#define _GLFW_CURSOR_CACHE_SIZE 16
+
+// Event types of the input trace format
+// These values are stored in trace files and must not be changed
+//
+#define _GLFW_RECORD_SYNC               0
+#define _GLFW_RECORD_KEY                1
+#define _GLFW_RECORD_CHAR               2
+#define _GLFW_RECORD_MOUSE_BUTTON       3
+#define _GLFW_RECORD_CURSOR_POS         4
+#define _GLFW_RECORD_CURSOR_ENTER       5
+#define _GLFW_RECORD_SCROLL             6
+#define _GLFW_RECORD_DROP               7
+#define _GLFW_RECORD_WINDOW_POS         8
+#define _GLFW_RECORD_WINDOW_SIZE        9
+#define _GLFW_RECORD_FRAMEBUFFER_SIZE   10
+#define _GLFW_RECORD_CONTENT_SCALE      11
+#define _GLFW_RECORD_WINDOW_FOCUS       12
+#define _GLFW_RECORD_WINDOW_ICONIFY     13
+#define _GLFW_RECORD_WINDOW_MAXIMIZE    14
+#define _GLFW_RECORD_WINDOW_DAMAGE      15
+#define _GLFW_RECORD_WINDOW_CLOSE       16
+
 typedef int GLFWbool;
 
 typedef struct _GLFWerror       _GLFWerror;
+typedef struct _GLFWerrorarg    _GLFWerrorarg;
 typedef struct _GLFWinitconfig  _GLFWinitconfig;
 typedef struct _GLFWwndconfig   _GLFWwndconfig;
 typedef struct _GLFWctxconfig   _GLFWctxconfig;
@@ -75,6 +141,11 @@ typedef struct _GLFWmapping     _GLFWmapping;
 typedef struct _GLFWjoystick    _GLFWjoystick;
 typedef struct _GLFWtls         _GLFWtls;
 typedef struct _GLFWmutex       _GLFWmutex;
+typedef struct _GLFWrecorder    _GLFWrecorder;
+typedef struct _GLFWreplayer    _GLFWreplayer;
+typedef struct _GLFWuserevent   _GLFWuserevent;
+typedef struct _GLFWvkentry     _GLFWvkentry;
+typedef struct _GLFWvkpresent   _GLFWvkpresent;
 
 typedef void (* _GLFWmakecontextcurrentfun)(_GLFWwindow*);
 typedef void (* _GLFWswapbuffersfun)(_GLFWwindow*);
@@ -128,6 +199,7 @@ typedef enum VkStructureType
     VK_STRUCTURE_TYPE_WAYLAND_SURFACE_CREATE_INFO_KHR = 1000006000,
     VK_STRUCTURE_TYPE_WIN32_SURFACE_CREATE_INFO_KHR = 1000009000,
     VK_STRUCTURE_TYPE_MACOS_SURFACE_CREATE_INFO_MVK = 1000123000,
+    VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT = 1000256000,
     VK_STRUCTURE_TYPE_MAX_ENUM = 0x7FFFFFFF
 } VkStructureType;
 
@@ -214,6 +286,22 @@ typedef void (APIENTRY * PFN_vkVoidFunction)(void);
         return x;                                    \
     }
 
+// Reports the beginning and end of a traced operation, costing only a pointer
+// comparison when no trace callback is set
+#define _GLFW_TRACE_BEGIN(name)                  \
+    {                                            \
+        if (_glfwTraceCallback)                  \
+            _glfwInputTrace(name, GLFW_TRUE);    \
+    }
+#define _GLFW_TRACE_END(name)                    \
+    {                                            \
+        if (_glfwTraceCallback)                  \
+            _glfwInputTrace(name, GLFW_FALSE);   \
+    }
+
+// Adds to the specified internal counter, see glfwGetInternalCounters
+#define _GLFW_COUNT(counter, n) (_glfw.counters[counter] += (n))
+
 // Swaps the provided pointers
 #define _GLFW_SWAP_POINTERS(x, y) \
     {                             \
@@ -223,12 +311,40 @@ typedef void (APIENTRY * PFN_vkVoidFunction)(void);
         y = t;                    \
     }
 
+// Stored format argument of a deferred error description
+//
+struct _GLFWerrorarg
+{
+    int             type;
+    union {
+        int         i;
+        long        l;
+        long long   ll;
+        size_t      z;
+        double      d;
+        const void* p;
+        const char* s;
+    } value;
+};
+
 // Per-thread error structure
 //
+// The description is formatted from the format string and the stored arguments
+// only when it is requested, as most errors are never looked at
+//
 struct _GLFWerror
 {
     _GLFWerror*     next;
     int             code;
+    // The format string of a description not yet formatted, or NULL
+    const char*     format;
+    _GLFWerrorarg   args[_GLFW_ERROR_ARG_COUNT];
+    int             argCount;
+    // Copies of the string arguments
+    char            strings[_GLFW_MESSAGE_SIZE];
+    size_t          stringSize;
+    // The formatted description or a static default description
+    const char*     message;
     char            description[_GLFW_MESSAGE_SIZE];
 };
 
@@ -239,10 +355,16 @@ struct _GLFWerror
 struct _GLFWinitconfig
 {
     GLFWbool      hatButtons;
+    GLFWbool      virtualClock;
+    GLFWbool      tscTimer;
+    GLFWbool      vulkanCache;
     struct {
         GLFWbool  menubar;
         GLFWbool  chdir;
     } ns;
+    struct {
+        GLFWbool  asyncWindows;
+    } x11;
 };
 
 // Window configuration
@@ -365,6 +487,8 @@ struct _GLFWcontext
 struct _GLFWwindow
 {
     struct _GLFWwindow* next;
+    // Creation order of the window, used to identify it in input traces
+    unsigned int        serial;
 
     // Window settings and state
     GLFWbool            resizable;
@@ -411,13 +535,48 @@ struct _GLFWwindow
         GLFWkeyfun              key;
         GLFWcharfun             character;
         GLFWcharmodsfun         charmods;
+        GLFWtextfun             text;
         GLFWdropfun             drop;
+        GLFWdropstreamfun       dropStream;
+        GLFWusereventfun        user;
     } callbacks;
 
     // This is defined in the window API's platform.h
     _GLFW_PLATFORM_WINDOW_STATE;
 };
 
+// User event queue slot
+//
+struct _GLFWuserevent
+{
+    // Equal to the enqueue position when free and to the position plus one
+    // when holding an event
+    unsigned int    sequence;
+    _GLFWwindow*    window;
+    unsigned int    serial;
+    uint64_t        data;
+};
+
+// Cached Vulkan entry point
+//
+struct _GLFWvkentry
+{
+    VkInstance      instance;
+    uint32_t        hash;
+    char*           name;
+    GLFWvkproc      proc;
+};
+
+// Cached Vulkan queue family presentation support
+//
+struct _GLFWvkpresent
+{
+    VkInstance      instance;
+    VkPhysicalDevice device;
+    uint32_t        queuefamily;
+    int             supported;
+};
+
 // Monitor structure
 //
 struct _GLFWmonitor
@@ -437,6 +596,12 @@ struct _GLFWmonitor
 
     GLFWgammaramp   originalRamp;
     GLFWgammaramp   currentRamp;
+    // The ramp last set by GLFW, used to skip setting an identical ramp
+    GLFWgammaramp   lastRamp;
+    // Scratch ramp for glfwSetGamma and the logarithms of its intensities
+    unsigned short* gammaValues;
+    float*          gammaLogs;
+    unsigned int    gammaSize;
 
     // This is defined in the window API's platform.h
     _GLFW_PLATFORM_MONITOR_STATE;
@@ -447,6 +612,15 @@ struct _GLFWmonitor
 struct _GLFWcursor
 {
     _GLFWcursor*    next;
+    // Number of live handles, zero for cursors only kept in the cache
+    int             refCount;
+
+    // Cache key, either a standard shape or a copy of the image and hotspot
+    uint64_t        hash;
+    int             shape;
+    int             width, height;
+    int             xhot, yhot;
+    unsigned char*  pixels;
 
     // This is defined in the window API's platform.h
     _GLFW_PLATFORM_CURSOR_STATE;
@@ -513,6 +687,7 @@ struct _GLFWmutex
 struct _GLFWlibrary
 {
     GLFWbool            initialized;
+    GLFWallocator       allocator;
 
     struct {
         _GLFWinitconfig init;
@@ -522,23 +697,56 @@ struct _GLFWlibrary
         int             refreshRate;
     } hints;
 
+#if !defined(_GLFW_THREAD_LOCAL)
     _GLFWerror*         errorListHead;
+#endif
     _GLFWcursor*        cursorListHead;
+    int                 cachedCursorCount;
     _GLFWwindow*        windowListHead;
+    unsigned int        windowSerial;
+
+    _GLFWrecorder*      recorder;
+    _GLFWreplayer*      replayer;
+
+    // Bounded lock-free queue of user events posted from any thread
+    // The producer and consumer positions are kept on separate cache lines
+    struct {
+        unsigned int    enqueue;
+        // Whether a wakeup has been posted since the queue was last drained
+        unsigned int    wakeup;
+        char            padding1[56];
+        unsigned int    dequeue;
+        char            padding2[60];
+        _GLFWuserevent  slots[_GLFW_USER_EVENT_CAPACITY];
+    } userEvents;
 
     _GLFWmonitor**      monitors;
     int                 monitorCount;
 
+    // Joysticks and mappings are initialized on first use
+    GLFWbool            joysticksInitialized;
+    GLFWbool            mappingsInitialized;
     _GLFWjoystick       joysticks[GLFW_JOYSTICK_LAST + 1];
     _GLFWmapping*       mappings;
     int                 mappingCount;
 
+    GLFWinitphase       initPhases[_GLFW_INIT_PHASE_COUNT];
+    int                 initPhaseCount;
+
+    // Round trips and system calls made since the counters were last reset
+    uint64_t            counters[_GLFW_COUNTER_COUNT];
+    GLFWcounter         counterValues[_GLFW_COUNTER_COUNT];
+
+#if !defined(_GLFW_THREAD_LOCAL)
     _GLFWtls            errorSlot;
-    _GLFWtls            contextSlot;
     _GLFWmutex          errorLock;
+#endif
+    _GLFWtls            contextSlot;
 
     struct {
         uint64_t        offset;
+        // Current value of the virtual clock, if enabled
+        uint64_t        virtualValue;
         // This is defined in the platform's time.h
         _GLFW_PLATFORM_LIBRARY_TIMER_STATE;
     } timer;
@@ -561,7 +769,17 @@ struct _GLFWlibrary
         GLFWbool        KHR_xcb_surface;
 #elif defined(_GLFW_WAYLAND)
         GLFWbool        KHR_wayland_surface;
+#elif defined(_GLFW_OSMESA)
+        GLFWbool        EXT_headless_surface;
 #endif
+        // Open addressing table of resolved entry points
+        // The cache may be used from any thread and is guarded by the lock
+        _GLFWmutex      lock;
+        _GLFWvkentry*   entries;
+        uint32_t        entryCount;
+        uint32_t        entryCapacity;
+        _GLFWvkpresent* presents;
+        int             presentCount;
     } vk;
 
     struct {
@@ -585,6 +803,10 @@ struct _GLFWlibrary
 //
 extern _GLFWlibrary _glfw;
 
+// The trace callback, outside of _glfw so it is kept across initialization
+//
+extern GLFWtracefun _glfwTraceCallback;
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -621,9 +843,12 @@ void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
 void _glfwPlatformSetClipboardString(const char* string);
 const char* _glfwPlatformGetClipboardString(void);
 
+GLFWbool _glfwPlatformInitJoysticks(void);
+void _glfwPlatformTerminateJoysticks(void);
 int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode);
 void _glfwPlatformUpdateGamepadGUID(char* guid);
 
+void _glfwPlatformInitTimer(void);
 uint64_t _glfwPlatformGetTimerValue(void);
 uint64_t _glfwPlatformGetTimerFrequency(void);
 
@@ -674,6 +899,7 @@ void _glfwPlatformSetWindowOpacity(_GLFWwindow* window, float opacity);
 void _glfwPlatformPollEvents(void);
 void _glfwPlatformWaitEvents(void);
 void _glfwPlatformWaitEventsTimeout(double timeout);
+void _glfwPlatformWaitEventsUntil(uint64_t deadline);
 void _glfwPlatformPostEmptyEvent(void);
 
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions);
@@ -716,11 +942,15 @@ void _glfwInputKey(_GLFWwindow* window,
                    int key, int scancode, int action, int mods);
 void _glfwInputChar(_GLFWwindow* window,
                     unsigned int codepoint, int mods, GLFWbool plain);
+void _glfwInputText(_GLFWwindow* window,
+                    char* text, size_t length, int mods, GLFWbool plain);
 void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset);
 void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods);
 void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos);
 void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered);
 void _glfwInputDrop(_GLFWwindow* window, int count, const char** names);
+void _glfwInputDropStream(_GLFWwindow* window,
+                          int count, const char** names, GLFWbool last);
 void _glfwInputJoystick(_GLFWjoystick* js, int event);
 void _glfwInputJoystickAxis(_GLFWjoystick* js, int axis, float value);
 void _glfwInputJoystickButton(_GLFWjoystick* js, int button, char value);
@@ -729,6 +959,8 @@ void _glfwInputJoystickHat(_GLFWjoystick* js, int hat, char value);
 void _glfwInputMonitor(_GLFWmonitor* monitor, int action, int placement);
 void _glfwInputMonitorWindow(_GLFWmonitor* monitor, _GLFWwindow* window);
 
+void _glfwInputTrace(const char* name, int begin);
+
 #if defined(__GNUC__)
 void _glfwInputError(int code, const char* format, ...)
     __attribute__((format(printf, 2, 3)));
@@ -765,11 +997,43 @@ _GLFWjoystick* _glfwAllocJoystick(const char* name,
                                   int hatCount);
 void _glfwFreeJoystick(_GLFWjoystick* js);
 void _glfwCenterCursorInContentArea(_GLFWwindow* window);
+void _glfwDestroyCursor(_GLFWcursor* cursor);
+uint64_t _glfwGetTimerValue(void);
+uint64_t _glfwGetTimerFrequency(void);
+void _glfwAdvanceTimer(uint64_t delta);
+
+void _glfwRecordEvent(int type, _GLFWwindow* window, int a, int b, int c, int d);
+void _glfwRecordMotion(int type, _GLFWwindow* window, double x, double y);
+void _glfwRecordDrop(_GLFWwindow* window, int count, const char** paths);
+void _glfwRecordSync(void);
+void _glfwReplayEvents(void);
+double _glfwGetReplayTimeout(void);
+void _glfwTerminateRecording(void);
 
 GLFWbool _glfwInitVulkan(int mode);
 void _glfwTerminateVulkan(void);
 const char* _glfwGetVulkanResultString(VkResult result);
-
+GLFWvkproc _glfwGetInstanceProcAddr(VkInstance instance, const char* procname);
+
+uint64_t _glfwBeginInitPhase(void);
+void _glfwEndInitPhase(const char* name, uint64_t start);
+
+void* _glfw_calloc(size_t count, size_t size);
+void* _glfw_realloc(void* block, size_t size);
+void _glfw_free(void* block);
+
+void _glfwSwizzlePixelsARGB(uint32_t* target,
+                            const unsigned char* source,
+                            size_t count);
+void _glfwPremultiplyPixelsARGB(uint32_t* target,
+                                const unsigned char* source,
+                                size_t count);
+void _glfwWidenPixelsARGB(long* target,
+                          const unsigned char* source,
+                          size_t count);
+
+size_t _glfwEncodeUTF8(char* s, unsigned int ch);
+unsigned int _glfwDecodeUTF8(const char** s);
 char* _glfw_strdup(const char* source);
 float _glfw_fminf(float a, float b);
 float _glfw_fmaxf(float a, float b);
@@ -262,9 +262,60 @@ static int compareJoysticks(const void* fp, const void* sp)
 //////                       GLFW internal API                      //////
 //////////////////////////////////////////////////////////////////////////
 
+void _glfwDetectJoystickConnectionLinux(void)
+{
+    ssize_t offset = 0;
+    char buffer[16384];
+
+    if (_glfw.linjs.inotify <= 0)
+        return;
+
+    _GLFW_TRACE_BEGIN("joystick.detect");
+    _GLFW_COUNT(_GLFW_COUNTER_INOTIFY_READ, 1);
+
+    const ssize_t size = read(_glfw.linjs.inotify, buffer, sizeof(buffer));
+
+    while (size > offset)
+    {
+        regmatch_t match;
+        const struct inotify_event* e = (struct inotify_event*) (buffer + offset);
+
+        offset += sizeof(struct inotify_event) + e->len;
+
+        if (regexec(&_glfw.linjs.regex, e->name, 1, &match, 0) != 0)
+            continue;
+
+        char path[PATH_MAX];
+        snprintf(path, sizeof(path), "/dev/input/%s", e->name);
+
+        if (e->mask & (IN_CREATE | IN_ATTRIB))
+            openJoystickDevice(path);
+        else if (e->mask & IN_DELETE)
+        {
+            int jid;
+
+            for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
+            {
+                if (strcmp(_glfw.joysticks[jid].linjs.path, path) == 0)
+                {
+                    closeJoystick(_glfw.joysticks + jid);
+                    break;
+                }
+            }
+        }
+    }
+
+    _GLFW_TRACE_END("joystick.detect");
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW platform API                      //////
+//////////////////////////////////////////////////////////////////////////
+
 // Initialize joystick interface
 //
-GLFWbool _glfwInitJoysticksLinux(void)
+GLFWbool _glfwPlatformInitJoysticks(void)
 {
     DIR* dir;
     int count = 0;
@@ -320,7 +371,7 @@ GLFWbool _glfwInitJoysticksLinux(void)
 
 // Close all opened joystick handles
 //
-void _glfwTerminateJoysticksLinux(void)
+void _glfwPlatformTerminateJoysticks(void)
 {
     int jid;
 
@@ -342,52 +393,6 @@ void _glfwTerminateJoysticksLinux(void)
     }
 }
 
-void _glfwDetectJoystickConnectionLinux(void)
-{
-    ssize_t offset = 0;
-    char buffer[16384];
-
-    if (_glfw.linjs.inotify <= 0)
-        return;
-
-    const ssize_t size = read(_glfw.linjs.inotify, buffer, sizeof(buffer));
-
-    while (size > offset)
-    {
-        regmatch_t match;
-        const struct inotify_event* e = (struct inotify_event*) (buffer + offset);
-
-        offset += sizeof(struct inotify_event) + e->len;
-
-        if (regexec(&_glfw.linjs.regex, e->name, 1, &match, 0) != 0)
-            continue;
-
-        char path[PATH_MAX];
-        snprintf(path, sizeof(path), "/dev/input/%s", e->name);
-
-        if (e->mask & (IN_CREATE | IN_ATTRIB))
-            openJoystickDevice(path);
-        else if (e->mask & IN_DELETE)
-        {
-            int jid;
-
-            for (jid = 0;  jid <= GLFW_JOYSTICK_LAST;  jid++)
-            {
-                if (strcmp(_glfw.joysticks[jid].linjs.path, path) == 0)
-                {
-                    closeJoystick(_glfw.joysticks + jid);
-                    break;
-                }
-            }
-        }
-    }
-}
-
-
-//////////////////////////////////////////////////////////////////////////
-//////                       GLFW platform API                      //////
-//////////////////////////////////////////////////////////////////////////
-
 int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode)
 {
     // Read all queued events (non-blocking)
@@ -396,6 +401,8 @@ int _glfwPlatformPollJoystick(_GLFWjoystick* js, int mode)
         struct input_event e;
 
         errno = 0;
+        _GLFW_COUNT(_GLFW_COUNTER_EVDEV_READ, 1);
+
         if (read(js->linjs.fd, &e, sizeof(e)) < 0)
         {
             // Reset the joystick slot if the device was disconnected
@@ -56,7 +56,5 @@ typedef struct _GLFWlibraryLinux
 } _GLFWlibraryLinux;
 
 
-GLFWbool _glfwInitJoysticksLinux(void);
-void _glfwTerminateJoysticksLinux(void);
 void _glfwDetectJoystickConnectionLinux(void);
 
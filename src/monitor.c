@@ -34,6 +34,12 @@
 #include <stdlib.h>
 #include <limits.h>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define _GLFW_GAMMA_SSE2
+ #include <emmintrin.h>
+#endif
+
 
 // Lexically compare video modes, used by qsort
 //
@@ -74,13 +80,185 @@ static GLFWbool refreshVideoModes(_GLFWmonitor* monitor)
 
     qsort(modes, modeCount, sizeof(GLFWvidmode), compareVideoModes);
 
-    free(monitor->modes);
+    _glfw_free(monitor->modes);
     monitor->modes = modes;
     monitor->modeCount = modeCount;
 
     return GLFW_TRUE;
 }
 
+// Allocates the scratch ramp of the specified monitor and caches the natural
+// logarithms of its intensities, unless already done for the current size
+//
+static GLFWbool refreshGammaTable(_GLFWmonitor* monitor)
+{
+    unsigned int i;
+    const unsigned int size = monitor->originalRamp.size;
+
+    if (monitor->gammaSize == size)
+        return GLFW_TRUE;
+
+    _glfw_free(monitor->gammaValues);
+    _glfw_free(monitor->gammaLogs);
+    monitor->gammaValues = _glfw_calloc(size, sizeof(unsigned short));
+    monitor->gammaLogs = _glfw_calloc(size, sizeof(float));
+    monitor->gammaSize = 0;
+
+    if (!monitor->gammaValues || !monitor->gammaLogs)
+        return GLFW_FALSE;
+
+    // The intensities are calculated exactly as for the previous powf based
+    // implementation, so the curves are the same
+    for (i = 0;  i < size;  i++)
+    {
+        if (size > 1)
+            monitor->gammaLogs[i] = logf(i / (float) (size - 1));
+        else
+            monitor->gammaLogs[i] = 0.f;
+    }
+
+    monitor->gammaSize = size;
+    return GLFW_TRUE;
+}
+
+// Raises intensities to the specified exponent, given their natural logarithms,
+// and scales the results to 16-bit ramp values
+//
+// The base 2 logarithm of each result is split into an integer part, which
+// becomes the float exponent, and a fraction in [-0.5, 0.5], for which 2^f is
+// approximated by its Taylor polynomial of degree 7.  The relative error is far
+// below the precision of the ramp.  The vector version gives the same results
+// as the scalar version, which also handles the values left over by it.
+//
+static void evaluateGammaScalar(unsigned short* values,
+                                const float* logs,
+                                unsigned int count,
+                                float exponent)
+{
+    unsigned int i;
+    const float scale = exponent * 1.44269504f;
+
+    for (i = 0;  i < count;  i++)
+    {
+        int whole;
+        uint32_t bits;
+        float t, f, p, value;
+
+        // Base 2 logarithm of the result, clamped to the normal float range
+        t = logs[i] * scale;
+        t = t > -126.f ? t : -126.f;
+
+        // Round to nearest, as t is never positive
+        whole = (int) (t - 0.5f);
+        f = t - (float) whole;
+
+        p = 1.52527338e-5f;
+        p = p * f + 1.54035304e-4f;
+        p = p * f + 1.33335581e-3f;
+        p = p * f + 9.61812911e-3f;
+        p = p * f + 5.55041087e-2f;
+        p = p * f + 2.40226507e-1f;
+        p = p * f + 6.93147181e-1f;
+        p = p * f + 1.f;
+
+        bits = (uint32_t) (whole + 127) << 23;
+        memcpy(&value, &bits, sizeof(value));
+
+        value = p * value * 65535.f + 0.5f;
+        value = value < 65535.f ? value : 65535.f;
+
+        values[i] = (unsigned short) value;
+    }
+}
+
+#if defined(_GLFW_GAMMA_SSE2)
+
+// Evaluates four values as described above, returning them as 32-bit integers
+//
+static __m128i evaluateGammaSSE2(__m128 logs, __m128 scale)
+{
+    __m128i whole;
+    __m128 t, f, p, value;
+
+    t = _mm_max_ps(_mm_mul_ps(logs, scale), _mm_set1_ps(-126.f));
+
+    whole = _mm_cvttps_epi32(_mm_sub_ps(t, _mm_set1_ps(0.5f)));
+    f = _mm_sub_ps(t, _mm_cvtepi32_ps(whole));
+
+    p = _mm_set1_ps(1.52527338e-5f);
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.54035304e-4f));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.33335581e-3f));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(9.61812911e-3f));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(5.55041087e-2f));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(2.40226507e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(6.93147181e-1f));
+    p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.f));
+
+    value = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(whole,
+                                                          _mm_set1_epi32(127)),
+                                            23));
+
+    value = _mm_mul_ps(_mm_mul_ps(p, value), _mm_set1_ps(65535.f));
+    value = _mm_add_ps(value, _mm_set1_ps(0.5f));
+    value = _mm_min_ps(value, _mm_set1_ps(65535.f));
+
+    return _mm_cvttps_epi32(value);
+}
+
+static unsigned int evaluateGammaVector(unsigned short* values,
+                                        const float* logs,
+                                        unsigned int count,
+                                        float exponent)
+{
+    const __m128 scale = _mm_set1_ps(exponent * 1.44269504f);
+    const __m128i bias32 = _mm_set1_epi32(32768);
+    const __m128i bias16 = _mm_set1_epi16((short) 0x8000);
+    unsigned int i;
+
+    // SSE2 can only pack to signed 16-bit values, so the values are biased
+    // into that range and back
+    for (i = 0;  i + 8 <= count;  i += 8)
+    {
+        const __m128i lo = evaluateGammaSSE2(_mm_loadu_ps(logs + i), scale);
+        const __m128i hi = evaluateGammaSSE2(_mm_loadu_ps(logs + i + 4), scale);
+        const __m128i x = _mm_packs_epi32(_mm_sub_epi32(lo, bias32),
+                                          _mm_sub_epi32(hi, bias32));
+        _mm_storeu_si128((__m128i*) (values + i), _mm_xor_si128(x, bias16));
+    }
+
+    return i;
+}
+
+#endif
+
+static void evaluateGamma(unsigned short* values,
+                          const float* logs,
+                          unsigned int count,
+                          float exponent)
+{
+    unsigned int done = 0;
+
+#if defined(_GLFW_GAMMA_SSE2)
+    done = evaluateGammaVector(values, logs, count, exponent);
+#endif
+
+    evaluateGammaScalar(values + done, logs + done, count - done, exponent);
+}
+
+// Returns whether the specified gamma ramps have the same contents
+//
+static GLFWbool isSameGammaRamp(const GLFWgammaramp* a, const GLFWgammaramp* b)
+{
+    const size_t size = b->size * sizeof(unsigned short);
+
+    if (a->size != b->size)
+        return GLFW_FALSE;
+
+    return memcmp(a->red, b->red, size) == 0 &&
+           memcmp(a->green, b->green, size) == 0 &&
+           memcmp(a->blue, b->blue, size) == 0;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -94,7 +272,7 @@ void _glfwInputMonitor(_GLFWmonitor* monitor, int action, int placement)
     {
         _glfw.monitorCount++;
         _glfw.monitors =
-            realloc(_glfw.monitors, sizeof(_GLFWmonitor*) * _glfw.monitorCount);
+            _glfw_realloc(_glfw.monitors, sizeof(_GLFWmonitor*) * _glfw.monitorCount);
 
         if (placement == _GLFW_INSERT_FIRST)
         {
@@ -149,6 +327,9 @@ void _glfwInputMonitor(_GLFWmonitor* monitor, int action, int placement)
 void _glfwInputMonitorWindow(_GLFWmonitor* monitor, _GLFWwindow* window)
 {
     monitor->window = window;
+
+    // Some platforms reset the gamma ramp when the video mode changes
+    _glfwFreeGammaArrays(&monitor->lastRamp);
 }
 
 
@@ -160,7 +341,7 @@ void _glfwInputMonitorWindow(_GLFWmonitor* monitor, _GLFWwindow* window)
 //
 _GLFWmonitor* _glfwAllocMonitor(const char* name, int widthMM, int heightMM)
 {
-    _GLFWmonitor* monitor = calloc(1, sizeof(_GLFWmonitor));
+    _GLFWmonitor* monitor = _glfw_calloc(1, sizeof(_GLFWmonitor));
     monitor->widthMM = widthMM;
     monitor->heightMM = heightMM;
 
@@ -181,19 +362,22 @@ void _glfwFreeMonitor(_GLFWmonitor* monitor)
 
     _glfwFreeGammaArrays(&monitor->originalRamp);
     _glfwFreeGammaArrays(&monitor->currentRamp);
+    _glfwFreeGammaArrays(&monitor->lastRamp);
 
-    free(monitor->modes);
-    free(monitor->name);
-    free(monitor);
+    _glfw_free(monitor->gammaValues);
+    _glfw_free(monitor->gammaLogs);
+    _glfw_free(monitor->modes);
+    _glfw_free(monitor->name);
+    _glfw_free(monitor);
 }
 
 // Allocates red, green and blue value arrays of the specified size
 //
 void _glfwAllocGammaArrays(GLFWgammaramp* ramp, unsigned int size)
 {
-    ramp->red = calloc(size, sizeof(unsigned short));
-    ramp->green = calloc(size, sizeof(unsigned short));
-    ramp->blue = calloc(size, sizeof(unsigned short));
+    ramp->red = _glfw_calloc(size, sizeof(unsigned short));
+    ramp->green = _glfw_calloc(size, sizeof(unsigned short));
+    ramp->blue = _glfw_calloc(size, sizeof(unsigned short));
     ramp->size = size;
 }
 
@@ -201,9 +385,9 @@ void _glfwAllocGammaArrays(GLFWgammaramp* ramp, unsigned int size)
 //
 void _glfwFreeGammaArrays(GLFWgammaramp* ramp)
 {
-    free(ramp->red);
-    free(ramp->green);
-    free(ramp->blue);
+    _glfw_free(ramp->red);
+    _glfw_free(ramp->green);
+    _glfw_free(ramp->blue);
 
     memset(ramp, 0, sizeof(GLFWgammaramp));
 }
@@ -448,11 +632,9 @@ GLFWAPI const GLFWvidmode* glfwGetVideoMode(GLFWmonitor* handle)
 
 GLFWAPI void glfwSetGamma(GLFWmonitor* handle, float gamma)
 {
-    unsigned int i;
-    unsigned short* values;
     GLFWgammaramp ramp;
-    const GLFWgammaramp* original;
-    assert(handle != NULL);
+    _GLFWmonitor* monitor = (_GLFWmonitor*) handle;
+    assert(monitor != NULL);
     assert(gamma > 0.f);
     assert(gamma <= FLT_MAX);
 
@@ -464,33 +646,26 @@ GLFWAPI void glfwSetGamma(GLFWmonitor* handle, float gamma)
         return;
     }
 
-    original = glfwGetGammaRamp(handle);
-    if (!original)
-        return;
-
-    values = calloc(original->size, sizeof(unsigned short));
-
-    for (i = 0;  i < original->size;  i++)
+    // The original ramp is needed anyway to restore it at termination and
+    // its size is that of every ramp this monitor accepts
+    if (!monitor->originalRamp.size)
     {
-        float value;
+        if (!_glfwPlatformGetGammaRamp(monitor, &monitor->originalRamp))
+            return;
+    }
 
-        // Calculate intensity
-        value = i / (float) (original->size - 1);
-        // Apply gamma curve
-        value = powf(value, 1.f / gamma) * 65535.f + 0.5f;
-        // Clamp to value range
-        value = _glfw_fminf(value, 65535.f);
+    if (!refreshGammaTable(monitor))
+        return;
 
-        values[i] = (unsigned short) value;
-    }
+    evaluateGamma(monitor->gammaValues, monitor->gammaLogs,
+                  monitor->gammaSize, 1.f / gamma);
 
-    ramp.red = values;
-    ramp.green = values;
-    ramp.blue = values;
-    ramp.size = original->size;
+    ramp.red = monitor->gammaValues;
+    ramp.green = monitor->gammaValues;
+    ramp.blue = monitor->gammaValues;
+    ramp.size = monitor->gammaSize;
 
     glfwSetGammaRamp(handle, &ramp);
-    free(values);
 }
 
 GLFWAPI const GLFWgammaramp* glfwGetGammaRamp(GLFWmonitor* handle)
@@ -500,6 +675,9 @@ GLFWAPI const GLFWgammaramp* glfwGetGammaRamp(GLFWmonitor* handle)
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
 
+    // The ramp may have been changed by someone else
+    _glfwFreeGammaArrays(&monitor->lastRamp);
+
     _glfwFreeGammaArrays(&monitor->currentRamp);
     if (!_glfwPlatformGetGammaRamp(monitor, &monitor->currentRamp))
         return NULL;
@@ -533,6 +711,31 @@ GLFWAPI void glfwSetGammaRamp(GLFWmonitor* handle, const GLFWgammaramp* ramp)
             return;
     }
 
+    if (isSameGammaRamp(&monitor->lastRamp, ramp))
+        return;
+
     _glfwPlatformSetGammaRamp(monitor, ramp);
+
+    // Only a ramp of the size the platform accepts can have been set
+    if (ramp->size != monitor->originalRamp.size)
+        return;
+
+    if (monitor->lastRamp.size != ramp->size)
+    {
+        _glfwFreeGammaArrays(&monitor->lastRamp);
+        _glfwAllocGammaArrays(&monitor->lastRamp, ramp->size);
+
+        if (!monitor->lastRamp.red ||
+            !monitor->lastRamp.green ||
+            !monitor->lastRamp.blue)
+        {
+            _glfwFreeGammaArrays(&monitor->lastRamp);
+            return;
+        }
+    }
+
+    memcpy(monitor->lastRamp.red, ramp->red, ramp->size * sizeof(unsigned short));
+    memcpy(monitor->lastRamp.green, ramp->green, ramp->size * sizeof(unsigned short));
+    memcpy(monitor->lastRamp.blue, ramp->blue, ramp->size * sizeof(unsigned short));
 }
 
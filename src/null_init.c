@@ -27,6 +27,65 @@
 
 #include "internal.h"
 
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+// Create key code translation tables
+//
+static void createKeyTables(void)
+{
+    int i, key;
+    // The virtual keyboard uses the key tokens as its scancodes
+    const int ranges[][2] =
+    {
+        { GLFW_KEY_SPACE, GLFW_KEY_SPACE },
+        { GLFW_KEY_APOSTROPHE, GLFW_KEY_APOSTROPHE },
+        { GLFW_KEY_COMMA, GLFW_KEY_9 },
+        { GLFW_KEY_SEMICOLON, GLFW_KEY_SEMICOLON },
+        { GLFW_KEY_EQUAL, GLFW_KEY_EQUAL },
+        { GLFW_KEY_A, GLFW_KEY_RIGHT_BRACKET },
+        { GLFW_KEY_GRAVE_ACCENT, GLFW_KEY_GRAVE_ACCENT },
+        { GLFW_KEY_WORLD_1, GLFW_KEY_WORLD_2 },
+        { GLFW_KEY_ESCAPE, GLFW_KEY_END },
+        { GLFW_KEY_CAPS_LOCK, GLFW_KEY_PAUSE },
+        { GLFW_KEY_F1, GLFW_KEY_F25 },
+        { GLFW_KEY_KP_0, GLFW_KEY_KP_EQUAL },
+        { GLFW_KEY_LEFT_SHIFT, GLFW_KEY_MENU }
+    };
+
+    memset(_glfw.null.scancodes, -1, sizeof(_glfw.null.scancodes));
+    memset(_glfw.null.keynames, 0, sizeof(_glfw.null.keynames));
+
+    for (i = 0;  i < sizeof(ranges) / sizeof(ranges[0]);  i++)
+    {
+        for (key = ranges[i][0];  key <= ranges[i][1];  key++)
+            _glfw.null.scancodes[key] = (short int) key;
+    }
+
+    for (key = GLFW_KEY_APOSTROPHE;  key <= GLFW_KEY_GRAVE_ACCENT;  key++)
+    {
+        if (_glfw.null.scancodes[key] == -1)
+            continue;
+
+        if (key >= GLFW_KEY_A && key <= GLFW_KEY_Z)
+            _glfw.null.keynames[key][0] = (char) (key - GLFW_KEY_A + 'a');
+        else
+            _glfw.null.keynames[key][0] = (char) key;
+    }
+
+    for (key = GLFW_KEY_KP_0;  key <= GLFW_KEY_KP_9;  key++)
+        _glfw.null.keynames[key][0] = (char) (key - GLFW_KEY_KP_0 + '0');
+
+    _glfw.null.keynames[GLFW_KEY_KP_DECIMAL][0]  = '.';
+    _glfw.null.keynames[GLFW_KEY_KP_DIVIDE][0]   = '/';
+    _glfw.null.keynames[GLFW_KEY_KP_MULTIPLY][0] = '*';
+    _glfw.null.keynames[GLFW_KEY_KP_SUBTRACT][0] = '-';
+    _glfw.null.keynames[GLFW_KEY_KP_ADD][0]      = '+';
+    _glfw.null.keynames[GLFW_KEY_KP_EQUAL][0]    = '=';
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -34,12 +93,51 @@
 
 int _glfwPlatformInit(void)
 {
-    _glfwInitTimerPOSIX();
+    pthread_condattr_t attr;
+
+    if (pthread_mutex_init(&_glfw.null.eventLock, NULL) != 0)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to create event queue mutex");
+        return GLFW_FALSE;
+    }
+
+    // Timed waits are measured against the same clock as the timer
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+
+    if (pthread_cond_init(&_glfw.null.eventCond, &attr) != 0)
+    {
+        pthread_condattr_destroy(&attr);
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to create event queue condition");
+        return GLFW_FALSE;
+    }
+
+    pthread_condattr_destroy(&attr);
+
+    {
+        const uint64_t start = _glfwBeginInitPhase();
+        createKeyTables();
+        _glfwEndInitPhase("key tables", start);
+    }
+
+    {
+        const uint64_t start = _glfwBeginInitPhase();
+        _glfwPollMonitorsNull();
+        _glfwEndInitPhase("monitors", start);
+    }
+
     return GLFW_TRUE;
 }
 
 void _glfwPlatformTerminate(void)
 {
+    _glfwFreeEventsNull();
+    pthread_cond_destroy(&_glfw.null.eventCond);
+    pthread_mutex_destroy(&_glfw.null.eventLock);
+
+    _glfw_free(_glfw.null.clipboardString);
     _glfwTerminateOSMesa();
 }
 
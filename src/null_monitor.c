@@ -27,6 +27,73 @@
 
 #include "internal.h"
 
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+// Allocates a virtual monitor with the specified video modes
+// The first mode is used as the desktop mode
+//
+static _GLFWmonitor* createMonitor(const char* name,
+                                   int widthMM, int heightMM,
+                                   const GLFWvidmode* modes, int count)
+{
+    unsigned int i;
+    _GLFWmonitor* monitor = _glfwAllocMonitor(name, widthMM, heightMM);
+
+    monitor->null.modes = _glfw_calloc(count, sizeof(GLFWvidmode));
+    memcpy(monitor->null.modes, modes, count * sizeof(GLFWvidmode));
+    monitor->null.modeCount = count;
+    monitor->null.mode = modes[0];
+    monitor->null.desktopMode = modes[0];
+    monitor->null.xscale = 1.f;
+    monitor->null.yscale = 1.f;
+    monitor->null.workareaWidth = modes[0].width;
+    monitor->null.workareaHeight = modes[0].height;
+
+    _glfwAllocGammaArrays(&monitor->null.ramp, 256);
+
+    for (i = 0;  i < monitor->null.ramp.size;  i++)
+    {
+        const unsigned short value = (unsigned short) (i * 257);
+        monitor->null.ramp.red[i] = value;
+        monitor->null.ramp.green[i] = value;
+        monitor->null.ramp.blue[i] = value;
+    }
+
+    return monitor;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Connects the default virtual monitor
+//
+void _glfwPollMonitorsNull(void)
+{
+    const GLFWvidmode modes[] =
+    {
+        { 1920, 1080, 8, 8, 8, 60 },
+        { 640, 480, 8, 8, 8, 60 },
+        { 800, 600, 8, 8, 8, 60 },
+        { 1024, 768, 8, 8, 8, 60 },
+        { 1280, 720, 8, 8, 8, 60 },
+        { 1280, 1024, 8, 8, 8, 60 },
+        { 1920, 1080, 8, 8, 8, 30 }
+    };
+    const float dpi = 141.f;
+    _GLFWmonitor* monitor =
+        createMonitor("Null SuperNoop 0",
+                      (int) (modes[0].width * 25.4f / dpi),
+                      (int) (modes[0].height * 25.4f / dpi),
+                      modes, sizeof(modes) / sizeof(modes[0]));
+
+    _glfwInputMonitor(monitor, GLFW_CONNECTED, _GLFW_INSERT_FIRST);
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -34,42 +101,188 @@
 
 void _glfwPlatformFreeMonitor(_GLFWmonitor* monitor)
 {
+    _glfw_free(monitor->null.modes);
+    _glfwFreeGammaArrays(&monitor->null.ramp);
 }
 
 void _glfwPlatformGetMonitorPos(_GLFWmonitor* monitor, int* xpos, int* ypos)
 {
+    if (xpos)
+        *xpos = monitor->null.xpos;
+    if (ypos)
+        *ypos = monitor->null.ypos;
 }
 
 void _glfwPlatformGetMonitorContentScale(_GLFWmonitor* monitor,
                                          float* xscale, float* yscale)
 {
     if (xscale)
-        *xscale = 1.f;
+        *xscale = monitor->null.xscale;
     if (yscale)
-        *yscale = 1.f;
+        *yscale = monitor->null.yscale;
 }
 
 void _glfwPlatformGetMonitorWorkarea(_GLFWmonitor* monitor,
                                      int* xpos, int* ypos,
                                      int* width, int* height)
 {
+    if (xpos)
+        *xpos = monitor->null.xpos + monitor->null.workareaX;
+    if (ypos)
+        *ypos = monitor->null.ypos + monitor->null.workareaY;
+    if (width)
+        *width = monitor->null.workareaWidth;
+    if (height)
+        *height = monitor->null.workareaHeight;
 }
 
 GLFWvidmode* _glfwPlatformGetVideoModes(_GLFWmonitor* monitor, int* found)
 {
-    return NULL;
+    GLFWvidmode* modes = _glfw_calloc(monitor->null.modeCount, sizeof(GLFWvidmode));
+    memcpy(modes, monitor->null.modes,
+           monitor->null.modeCount * sizeof(GLFWvidmode));
+
+    *found = monitor->null.modeCount;
+    return modes;
 }
 
 void _glfwPlatformGetVideoMode(_GLFWmonitor* monitor, GLFWvidmode* mode)
 {
+    *mode = monitor->null.mode;
 }
 
 GLFWbool _glfwPlatformGetGammaRamp(_GLFWmonitor* monitor, GLFWgammaramp* ramp)
 {
-    return GLFW_FALSE;
+    const size_t size = monitor->null.ramp.size * sizeof(unsigned short);
+
+    _glfwAllocGammaArrays(ramp, monitor->null.ramp.size);
+    memcpy(ramp->red, monitor->null.ramp.red, size);
+    memcpy(ramp->green, monitor->null.ramp.green, size);
+    memcpy(ramp->blue, monitor->null.ramp.blue, size);
+    return GLFW_TRUE;
 }
 
 void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
 {
+    const size_t size = ramp->size * sizeof(unsigned short);
+
+    if (monitor->null.ramp.size != ramp->size)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Gamma ramp size must match current ramp size");
+        return;
+    }
+
+    memcpy(monitor->null.ramp.red, ramp->red, size);
+    memcpy(monitor->null.ramp.green, ramp->green, size);
+    memcpy(monitor->null.ramp.blue, ramp->blue, size);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                        GLFW native API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWAPI GLFWmonitor* glfwNullConnectMonitor(const char* name,
+                                            int widthMM, int heightMM,
+                                            const GLFWvidmode* modes,
+                                            int count)
+{
+    _GLFWmonitor* monitor;
+    _GLFWeventNull event = {0};
+
+    assert(name != NULL);
+    assert(modes != NULL);
+    assert(count > 0);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (count <= 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid video mode count %i", count);
+        return NULL;
+    }
+
+    monitor = createMonitor(name, widthMM, heightMM, modes, count);
+    monitor->null.pending = GLFW_TRUE;
+
+    event.type = _GLFW_NULL_MONITOR_EVENT;
+    event.monitor = monitor;
+    event.action = GLFW_CONNECTED;
+    _glfwEnqueueEventNull(&event);
+
+    return (GLFWmonitor*) monitor;
+}
+
+GLFWAPI void glfwNullDisconnectMonitor(GLFWmonitor* handle)
+{
+    _GLFWmonitor* monitor = (_GLFWmonitor*) handle;
+    _GLFWeventNull event = {0};
+    assert(monitor != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (monitor->null.pending)
+        return;
+
+    monitor->null.pending = GLFW_TRUE;
+
+    event.type = _GLFW_NULL_MONITOR_EVENT;
+    event.monitor = monitor;
+    event.action = GLFW_DISCONNECTED;
+    _glfwEnqueueEventNull(&event);
+}
+
+GLFWAPI void glfwNullSetMonitorPos(GLFWmonitor* handle, int xpos, int ypos)
+{
+    _GLFWmonitor* monitor = (_GLFWmonitor*) handle;
+    assert(monitor != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    monitor->null.xpos = xpos;
+    monitor->null.ypos = ypos;
+}
+
+GLFWAPI void glfwNullSetMonitorContentScale(GLFWmonitor* handle,
+                                            float xscale, float yscale)
+{
+    _GLFWmonitor* monitor = (_GLFWmonitor*) handle;
+    assert(monitor != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (xscale <= 0.f || yscale <= 0.f)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid content scale %f %f", xscale, yscale);
+        return;
+    }
+
+    monitor->null.xscale = xscale;
+    monitor->null.yscale = yscale;
+}
+
+GLFWAPI void glfwNullSetMonitorWorkarea(GLFWmonitor* handle,
+                                        int xpos, int ypos,
+                                        int width, int height)
+{
+    _GLFWmonitor* monitor = (_GLFWmonitor*) handle;
+    assert(monitor != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (width <= 0 || height <= 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid work area size %ix%i", width, height);
+        return;
+    }
+
+    monitor->null.workareaX = xpos;
+    monitor->null.workareaY = ypos;
+    monitor->null.workareaWidth = width;
+    monitor->null.workareaHeight = height;
 }
 
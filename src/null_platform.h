@@ -27,12 +27,24 @@
 
 #include <dlfcn.h>
 
+typedef VkFlags VkHeadlessSurfaceCreateFlagsEXT;
+
+typedef struct VkHeadlessSurfaceCreateInfoEXT
+{
+    VkStructureType                 sType;
+    const void*                     pNext;
+    VkHeadlessSurfaceCreateFlagsEXT flags;
+} VkHeadlessSurfaceCreateInfoEXT;
+
+typedef VkResult (APIENTRY *PFN_vkCreateHeadlessSurfaceEXT)(VkInstance,const VkHeadlessSurfaceCreateInfoEXT*,const VkAllocationCallbacks*,VkSurfaceKHR*);
+
 #define _GLFW_PLATFORM_WINDOW_STATE _GLFWwindowNull null
 
+#define _GLFW_PLATFORM_MONITOR_STATE _GLFWmonitorNull null
+#define _GLFW_PLATFORM_LIBRARY_WINDOW_STATE _GLFWlibraryNull null
+
 #define _GLFW_PLATFORM_CONTEXT_STATE
-#define _GLFW_PLATFORM_MONITOR_STATE
 #define _GLFW_PLATFORM_CURSOR_STATE
-#define _GLFW_PLATFORM_LIBRARY_WINDOW_STATE
 #define _GLFW_PLATFORM_LIBRARY_CONTEXT_STATE
 #define _GLFW_EGL_CONTEXT_STATE
 #define _GLFW_EGL_LIBRARY_CONTEXT_STATE
@@ -52,11 +64,121 @@
  #define _glfw_dlsym(handle, name) dlsym(handle, name)
 #endif
 
+#define _GLFW_NULL_FRAME_LEFT      1
+#define _GLFW_NULL_FRAME_TOP       10
+#define _GLFW_NULL_FRAME_RIGHT     1
+#define _GLFW_NULL_FRAME_BOTTOM    1
+
+// Injected event types
+//
+enum
+{
+    _GLFW_NULL_KEY_EVENT = 1,
+    _GLFW_NULL_CHAR_EVENT,
+    _GLFW_NULL_MOUSE_BUTTON_EVENT,
+    _GLFW_NULL_CURSOR_POS_EVENT,
+    _GLFW_NULL_CURSOR_ENTER_EVENT,
+    _GLFW_NULL_SCROLL_EVENT,
+    _GLFW_NULL_WINDOW_POS_EVENT,
+    _GLFW_NULL_WINDOW_SIZE_EVENT,
+    _GLFW_NULL_WINDOW_FOCUS_EVENT,
+    _GLFW_NULL_WINDOW_ICONIFY_EVENT,
+    _GLFW_NULL_WINDOW_CLOSE_EVENT,
+    _GLFW_NULL_MONITOR_EVENT,
+    _GLFW_NULL_TIME_EVENT
+};
+
+typedef void (* _GLFWnullframebufferfun)(GLFWwindow*,const unsigned char*,int,int,int);
+
+// Null-specific injected event
+//
+typedef struct _GLFWeventNull
+{
+    int             type;
+    _GLFWwindow*    window;
+    _GLFWmonitor*   monitor;
+    // Key, mouse button or boolean state
+    int             key;
+    int             scancode;
+    int             action;
+    int             mods;
+    unsigned int    codepoint;
+    // Position, size or offset
+    double          x, y;
+    // Virtual clock step
+    uint64_t        ticks;
+} _GLFWeventNull;
+
 // Null-specific per-window data
 //
 typedef struct _GLFWwindowNull
 {
-    int width;
-    int height;
+    int             xpos;
+    int             ypos;
+    int             width;
+    int             height;
+    GLFWbool        visible;
+    GLFWbool        iconified;
+    GLFWbool        maximized;
+    GLFWbool        resizable;
+    GLFWbool        decorated;
+    GLFWbool        floating;
+    GLFWbool        transparent;
+    GLFWbool        hovered;
+    float           opacity;
+    // Cursor position in content area coordinates
+    double          cursorPosX, cursorPosY;
+    // Software framebuffer, allocated when first mapped
+    unsigned char*  pixels;
+    int             pixelWidth;
+    int             pixelHeight;
+    GLFWbool        mapped;
+    _GLFWnullframebufferfun framebufferCallback;
 } _GLFWwindowNull;
 
+// Null-specific per-monitor data
+//
+typedef struct _GLFWmonitorNull
+{
+    int             xpos;
+    int             ypos;
+    float           xscale;
+    float           yscale;
+    int             workareaX, workareaY;
+    int             workareaWidth, workareaHeight;
+    GLFWvidmode*    modes;
+    int             modeCount;
+    GLFWvidmode     mode;
+    GLFWvidmode     desktopMode;
+    GLFWgammaramp   ramp;
+    // Whether a connection or disconnection event is still queued
+    GLFWbool        pending;
+} _GLFWmonitorNull;
+
+// Null-specific global data
+//
+typedef struct _GLFWlibraryNull
+{
+    _GLFWwindow*    focusedWindow;
+    char*           clipboardString;
+    short int       scancodes[GLFW_KEY_LAST + 1];
+    char            keynames[GLFW_KEY_LAST + 1][2];
+
+    pthread_mutex_t eventLock;
+    pthread_cond_t  eventCond;
+    GLFWbool        emptyEventPosted;
+    // Events queued by the injection functions, may be written from any thread
+    _GLFWeventNull* events;
+    int             eventCount;
+    int             eventCapacity;
+    // Events being dispatched by the current event processing call
+    _GLFWeventNull* dispatch;
+    int             dispatchCount;
+    int             dispatchCapacity;
+} _GLFWlibraryNull;
+
+
+void _glfwPollMonitorsNull(void);
+void _glfwEnqueueEventNull(const _GLFWeventNull* event);
+void _glfwFreeEventsNull(void);
+
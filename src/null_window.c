@@ -27,17 +27,450 @@
 
 #include "internal.h"
 
+#include <assert.h>
+#include <errno.h>
+#include <float.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+// Applies the window size limits and aspect ratio to the specified size
+//
+static void applySizeLimits(_GLFWwindow* window, int* width, int* height)
+{
+    if (window->numer != GLFW_DONT_CARE && window->denom != GLFW_DONT_CARE)
+    {
+        const float ratio = (float) window->numer / (float) window->denom;
+        *height = (int) (*width / ratio);
+    }
+
+    if (window->minwidth != GLFW_DONT_CARE && *width < window->minwidth)
+        *width = window->minwidth;
+    else if (window->maxwidth != GLFW_DONT_CARE && *width > window->maxwidth)
+        *width = window->maxwidth;
+
+    if (window->minheight != GLFW_DONT_CARE && *height < window->minheight)
+        *height = window->minheight;
+    else if (window->maxheight != GLFW_DONT_CARE && *height > window->maxheight)
+        *height = window->maxheight;
+}
+
+// Moves the window and reports the move if the position changed
+//
+static void moveWindow(_GLFWwindow* window, int xpos, int ypos)
+{
+    if (window->null.xpos == xpos && window->null.ypos == ypos)
+        return;
+
+    window->null.xpos = xpos;
+    window->null.ypos = ypos;
+    _glfwInputWindowPos(window, xpos, ypos);
+}
+
+// Makes the software framebuffer match the window size, keeping the pixels
+// of the overlapping region
+//
+static GLFWbool resizeFramebuffer(_GLFWwindow* window)
+{
+    unsigned char* pixels;
+    const int width = window->null.width;
+    const int height = window->null.height;
+    const int copyWidth = width < window->null.pixelWidth ?
+                          width : window->null.pixelWidth;
+    const int copyHeight = height < window->null.pixelHeight ?
+                           height : window->null.pixelHeight;
+    int y;
+
+    if (window->null.pixels &&
+        window->null.pixelWidth == width &&
+        window->null.pixelHeight == height)
+    {
+        return GLFW_TRUE;
+    }
+
+    pixels = _glfw_calloc((size_t) width * height, 4);
+    if (!pixels && width && height)
+    {
+        _glfwInputError(GLFW_OUT_OF_MEMORY,
+                        "Null: Failed to allocate framebuffer");
+        return GLFW_FALSE;
+    }
+
+    for (y = 0;  y < copyHeight;  y++)
+    {
+        memcpy(pixels + (size_t) y * width * 4,
+               window->null.pixels + (size_t) y * window->null.pixelWidth * 4,
+               (size_t) copyWidth * 4);
+    }
+
+    _glfw_free(window->null.pixels);
+    window->null.pixels = pixels;
+    window->null.pixelWidth = width;
+    window->null.pixelHeight = height;
+    return GLFW_TRUE;
+}
+
+// Resizes the window and reports the resize if the size changed
+//
+static void resizeWindow(_GLFWwindow* window, int width, int height)
+{
+    if (window->null.width == width && window->null.height == height)
+        return;
+
+    window->null.width = width;
+    window->null.height = height;
+
+    // A mapped framebuffer is resized when it is unmapped
+    if (window->null.pixels && !window->null.mapped)
+        resizeFramebuffer(window);
+
+    _glfwInputFramebufferSize(window, width, height);
+    _glfwInputWindowSize(window, width, height);
+    _glfwInputWindowDamage(window);
+}
+
+// Makes the window cover its monitor
+//
+static void fitToMonitor(_GLFWwindow* window)
+{
+    GLFWvidmode mode;
+    _glfwPlatformGetVideoMode(window->monitor, &mode);
+    moveWindow(window,
+               window->monitor->null.xpos,
+               window->monitor->null.ypos);
+    resizeWindow(window, mode.width, mode.height);
+}
+
+// Sets the video mode of the monitor to the one desired by the window
+//
+static void acquireMonitor(_GLFWwindow* window)
+{
+    const GLFWvidmode* mode = _glfwChooseVideoMode(window->monitor,
+                                                   &window->videoMode);
+    if (mode)
+        window->monitor->null.mode = *mode;
+
+    _glfwInputMonitorWindow(window->monitor, window);
+}
+
+// Restores the desktop video mode of the monitor
+//
+static void releaseMonitor(_GLFWwindow* window)
+{
+    if (window->monitor->window != window)
+        return;
+
+    _glfwInputMonitorWindow(window->monitor, NULL);
+    window->monitor->null.mode = window->monitor->null.desktopMode;
+}
+
+// Takes input focus from the window, if it has it
+//
+static void unfocusWindow(_GLFWwindow* window)
+{
+    if (_glfw.null.focusedWindow != window)
+        return;
+
+    _glfw.null.focusedWindow = NULL;
+    _glfwInputWindowFocus(window, GLFW_FALSE);
+
+    if (window->monitor && window->autoIconify)
+        _glfwPlatformIconifyWindow(window);
+}
+
+// Removes all queued events for the specified window
+//
+static void discardWindowEvents(_GLFWwindow* window)
+{
+    int i;
+
+    pthread_mutex_lock(&_glfw.null.eventLock);
+
+    for (i = 0;  i < _glfw.null.eventCount;  i++)
+    {
+        if (_glfw.null.events[i].window == window)
+            _glfw.null.events[i].type = 0;
+    }
+
+    for (i = 0;  i < _glfw.null.dispatchCount;  i++)
+    {
+        if (_glfw.null.dispatch[i].window == window)
+            _glfw.null.dispatch[i].type = 0;
+    }
+
+    pthread_mutex_unlock(&_glfw.null.eventLock);
+}
+
+// Dispatches a single injected event
+//
+static void processEvent(const _GLFWeventNull* event)
+{
+    _GLFWwindow* window = event->window;
+
+    switch (event->type)
+    {
+        case _GLFW_NULL_KEY_EVENT:
+            _glfwInputKey(window,
+                          event->key, event->scancode,
+                          event->action, event->mods);
+            return;
+
+        case _GLFW_NULL_CHAR_EVENT:
+        {
+            const int mods = event->mods;
+            const GLFWbool plain = !(mods & (GLFW_MOD_CONTROL | GLFW_MOD_ALT));
+            _glfwInputChar(window, event->codepoint, mods, plain);
+            return;
+        }
+
+        case _GLFW_NULL_MOUSE_BUTTON_EVENT:
+            _glfwInputMouseClick(window, event->key, event->action, event->mods);
+            return;
+
+        case _GLFW_NULL_CURSOR_POS_EVENT:
+        {
+            if (window->cursorMode == GLFW_CURSOR_DISABLED)
+            {
+                const double dx = event->x - window->null.cursorPosX;
+                const double dy = event->y - window->null.cursorPosY;
+
+                window->null.cursorPosX = event->x;
+                window->null.cursorPosY = event->y;
+                _glfwInputCursorPos(window,
+                                    window->virtualCursorPosX + dx,
+                                    window->virtualCursorPosY + dy);
+            }
+            else
+            {
+                window->null.cursorPosX = event->x;
+                window->null.cursorPosY = event->y;
+                _glfwInputCursorPos(window, event->x, event->y);
+            }
+
+            return;
+        }
+
+        case _GLFW_NULL_CURSOR_ENTER_EVENT:
+            if (window->null.hovered == event->key)
+                return;
+
+            window->null.hovered = event->key;
+            _glfwInputCursorEnter(window, event->key);
+            return;
+
+        case _GLFW_NULL_SCROLL_EVENT:
+            _glfwInputScroll(window, event->x, event->y);
+            return;
+
+        case _GLFW_NULL_WINDOW_POS_EVENT:
+            if (!window->monitor)
+                moveWindow(window, (int) event->x, (int) event->y);
+            return;
+
+        case _GLFW_NULL_WINDOW_SIZE_EVENT:
+        {
+            int width = (int) event->x;
+            int height = (int) event->y;
+
+            if (window->monitor)
+                return;
+
+            applySizeLimits(window, &width, &height);
+            resizeWindow(window, width, height);
+            return;
+        }
+
+        case _GLFW_NULL_WINDOW_FOCUS_EVENT:
+            if (event->key)
+                _glfwPlatformFocusWindow(window);
+            else
+                unfocusWindow(window);
+            return;
+
+        case _GLFW_NULL_WINDOW_ICONIFY_EVENT:
+            if (event->key)
+                _glfwPlatformIconifyWindow(window);
+            else
+                _glfwPlatformRestoreWindow(window);
+            return;
+
+        case _GLFW_NULL_WINDOW_CLOSE_EVENT:
+            _glfwInputWindowCloseRequest(window);
+            return;
+
+        case _GLFW_NULL_MONITOR_EVENT:
+            event->monitor->null.pending = GLFW_FALSE;
+            _glfwInputMonitor(event->monitor, event->action, _GLFW_INSERT_LAST);
+            return;
+
+        case _GLFW_NULL_TIME_EVENT:
+            _glfwAdvanceTimer(event->ticks);
+            return;
+    }
+}
+
+// Dispatches all events queued before the call
+//
+static void processEvents(void)
+{
+    int i;
+
+    pthread_mutex_lock(&_glfw.null.eventLock);
+
+    // Swap the queue with the dispatch array so that events may continue to be
+    // injected, including by callbacks, while the current batch is dispatched
+    {
+        _GLFWeventNull* events = _glfw.null.dispatch;
+        const int capacity = _glfw.null.dispatchCapacity;
+
+        _glfw.null.dispatch = _glfw.null.events;
+        _glfw.null.dispatchCount = _glfw.null.eventCount;
+        _glfw.null.dispatchCapacity = _glfw.null.eventCapacity;
+
+        _glfw.null.events = events;
+        _glfw.null.eventCount = 0;
+        _glfw.null.eventCapacity = capacity;
+    }
+
+    _glfw.null.emptyEventPosted = GLFW_FALSE;
+
+    pthread_mutex_unlock(&_glfw.null.eventLock);
+
+    for (i = 0;  i < _glfw.null.dispatchCount;  i++)
+        processEvent(_glfw.null.dispatch + i);
+
+    pthread_mutex_lock(&_glfw.null.eventLock);
+    _glfw.null.dispatchCount = 0;
+    pthread_mutex_unlock(&_glfw.null.eventLock);
+}
+
+// Returns whether there are events to process, must be called with the event
+// queue lock held
+//
+static GLFWbool eventsPending(void)
+{
+    return _glfw.null.eventCount > 0 || _glfw.null.emptyEventPosted;
+}
+
+// Waits for events for at most the specified time and processes them
+//
+static void waitEventsFor(const struct timespec* timeout)
+{
+    struct timespec deadline;
+
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    deadline.tv_sec += timeout->tv_sec;
+    deadline.tv_nsec += timeout->tv_nsec;
+    if (deadline.tv_nsec >= 1000000000)
+    {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000;
+    }
+
+    pthread_mutex_lock(&_glfw.null.eventLock);
+
+    while (!eventsPending())
+    {
+        if (pthread_cond_timedwait(&_glfw.null.eventCond,
+                                   &_glfw.null.eventLock,
+                                   &deadline) != 0)
+        {
+            break;
+        }
+    }
+
+    pthread_mutex_unlock(&_glfw.null.eventLock);
+
+    processEvents();
+}
+
+// Queues an event for the specified window
+//
+static void injectWindowEvent(_GLFWwindow* window, _GLFWeventNull* event)
+{
+    event->window = window;
+    _glfwEnqueueEventNull(event);
+}
 
 static int createNativeWindow(_GLFWwindow* window,
-                              const _GLFWwndconfig* wndconfig)
+                              const _GLFWwndconfig* wndconfig,
+                              const _GLFWfbconfig* fbconfig)
 {
     window->null.width = wndconfig->width;
     window->null.height = wndconfig->height;
+    window->null.visible = wndconfig->visible;
+    window->null.resizable = wndconfig->resizable;
+    window->null.decorated = wndconfig->decorated;
+    window->null.floating = wndconfig->floating;
+    window->null.transparent = fbconfig->transparent;
+    window->null.opacity = 1.f;
+
+    if (window->monitor)
+    {
+        window->null.visible = GLFW_TRUE;
+        acquireMonitor(window);
+        fitToMonitor(window);
+    }
 
     return GLFW_TRUE;
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Appends an event to the injected event queue and wakes up the event loop
+//
+void _glfwEnqueueEventNull(const _GLFWeventNull* event)
+{
+    pthread_mutex_lock(&_glfw.null.eventLock);
+
+    if (_glfw.null.eventCount == _glfw.null.eventCapacity)
+    {
+        if (_glfw.null.eventCapacity)
+            _glfw.null.eventCapacity *= 2;
+        else
+            _glfw.null.eventCapacity = 64;
+
+        _glfw.null.events = _glfw_realloc(_glfw.null.events,
+                                    _glfw.null.eventCapacity *
+                                    sizeof(_GLFWeventNull));
+    }
+
+    _glfw.null.events[_glfw.null.eventCount++] = *event;
+
+    pthread_cond_signal(&_glfw.null.eventCond);
+    pthread_mutex_unlock(&_glfw.null.eventLock);
+}
+
+// Frees the event queue and any monitors whose connection is still queued
+//
+void _glfwFreeEventsNull(void)
+{
+    int i;
+
+    for (i = 0;  i < _glfw.null.eventCount;  i++)
+    {
+        const _GLFWeventNull* event = _glfw.null.events + i;
+        if (event->type == _GLFW_NULL_MONITOR_EVENT &&
+            event->action == GLFW_CONNECTED)
+        {
+            _glfwFreeMonitor(event->monitor);
+        }
+    }
+
+    _glfw_free(_glfw.null.events);
+    _glfw_free(_glfw.null.dispatch);
+    _glfw.null.events = NULL;
+    _glfw.null.dispatch = NULL;
+    _glfw.null.eventCount = _glfw.null.eventCapacity = 0;
+    _glfw.null.dispatchCount = _glfw.null.dispatchCapacity = 0;
+}
+
+
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
 //////////////////////////////////////////////////////////////////////////
@@ -47,7 +480,7 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
                               const _GLFWctxconfig* ctxconfig,
                               const _GLFWfbconfig* fbconfig)
 {
-    if (!createNativeWindow(window, wndconfig))
+    if (!createNativeWindow(window, wndconfig, fbconfig))
         return GLFW_FALSE;
 
     if (ctxconfig->client != GLFW_NO_API)
@@ -67,13 +500,26 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
         }
     }
 
+    if (window->monitor && wndconfig->focused)
+        _glfwPlatformFocusWindow(window);
+
     return GLFW_TRUE;
 }
 
 void _glfwPlatformDestroyWindow(_GLFWwindow* window)
 {
+    if (_glfw.null.focusedWindow == window)
+        _glfw.null.focusedWindow = NULL;
+
+    if (window->monitor)
+        releaseMonitor(window);
+
+    discardWindowEvents(window);
+
     if (window->context.destroy)
         window->context.destroy(window);
+
+    _glfw_free(window->null.pixels);
 }
 
 void _glfwPlatformSetWindowTitle(_GLFWwindow* window, const char* title)
@@ -91,14 +537,54 @@ void _glfwPlatformSetWindowMonitor(_GLFWwindow* window,
                                    int width, int height,
                                    int refreshRate)
 {
+    if (window->monitor == monitor)
+    {
+        if (monitor)
+        {
+            if (monitor->window == window)
+            {
+                acquireMonitor(window);
+                fitToMonitor(window);
+            }
+        }
+        else
+        {
+            moveWindow(window, xpos, ypos);
+            resizeWindow(window, width, height);
+        }
+
+        return;
+    }
+
+    if (window->monitor)
+        releaseMonitor(window);
+
+    _glfwInputWindowMonitor(window, monitor);
+
+    if (window->monitor)
+    {
+        window->null.visible = GLFW_TRUE;
+        acquireMonitor(window);
+        fitToMonitor(window);
+    }
+    else
+    {
+        moveWindow(window, xpos, ypos);
+        resizeWindow(window, width, height);
+    }
 }
 
 void _glfwPlatformGetWindowPos(_GLFWwindow* window, int* xpos, int* ypos)
 {
+    if (xpos)
+        *xpos = window->null.xpos;
+    if (ypos)
+        *ypos = window->null.ypos;
 }
 
 void _glfwPlatformSetWindowPos(_GLFWwindow* window, int xpos, int ypos)
 {
+    moveWindow(window, xpos, ypos);
 }
 
 void _glfwPlatformGetWindowSize(_GLFWwindow* window, int* width, int* height)
@@ -111,18 +597,37 @@ void _glfwPlatformGetWindowSize(_GLFWwindow* window, int* width, int* height)
 
 void _glfwPlatformSetWindowSize(_GLFWwindow* window, int width, int height)
 {
-    window->null.width = width;
-    window->null.height = height;
+    if (window->monitor)
+    {
+        if (window->monitor->window == window)
+        {
+            acquireMonitor(window);
+            fitToMonitor(window);
+        }
+    }
+    else
+    {
+        applySizeLimits(window, &width, &height);
+        resizeWindow(window, width, height);
+    }
 }
 
 void _glfwPlatformSetWindowSizeLimits(_GLFWwindow* window,
                                       int minwidth, int minheight,
                                       int maxwidth, int maxheight)
 {
+    int width = window->null.width;
+    int height = window->null.height;
+    applySizeLimits(window, &width, &height);
+    resizeWindow(window, width, height);
 }
 
 void _glfwPlatformSetWindowAspectRatio(_GLFWwindow* window, int n, int d)
 {
+    int width = window->null.width;
+    int height = window->null.height;
+    applySizeLimits(window, &width, &height);
+    resizeWindow(window, width, height);
 }
 
 void _glfwPlatformGetFramebufferSize(_GLFWwindow* window, int* width, int* height)
@@ -137,63 +642,129 @@ void _glfwPlatformGetWindowFrameSize(_GLFWwindow* window,
                                      int* left, int* top,
                                      int* right, int* bottom)
 {
+    if (window->null.decorated && !window->monitor)
+    {
+        if (left)
+            *left = _GLFW_NULL_FRAME_LEFT;
+        if (top)
+            *top = _GLFW_NULL_FRAME_TOP;
+        if (right)
+            *right = _GLFW_NULL_FRAME_RIGHT;
+        if (bottom)
+            *bottom = _GLFW_NULL_FRAME_BOTTOM;
+    }
+    else
+    {
+        if (left)
+            *left = 0;
+        if (top)
+            *top = 0;
+        if (right)
+            *right = 0;
+        if (bottom)
+            *bottom = 0;
+    }
 }
 
 void _glfwPlatformGetWindowContentScale(_GLFWwindow* window,
                                         float* xscale, float* yscale)
 {
-    if (xscale)
-        *xscale = 1.f;
-    if (yscale)
-        *yscale = 1.f;
+    _GLFWmonitor* monitor = window->monitor;
+    if (!monitor && _glfw.monitorCount)
+        monitor = _glfw.monitors[0];
+
+    if (monitor)
+        _glfwPlatformGetMonitorContentScale(monitor, xscale, yscale);
+    else
+    {
+        if (xscale)
+            *xscale = 1.f;
+        if (yscale)
+            *yscale = 1.f;
+    }
 }
 
 void _glfwPlatformIconifyWindow(_GLFWwindow* window)
 {
+    if (window->null.iconified)
+        return;
+
+    unfocusWindow(window);
+
+    window->null.iconified = GLFW_TRUE;
+    _glfwInputWindowIconify(window, GLFW_TRUE);
+
+    if (window->monitor)
+        releaseMonitor(window);
 }
 
 void _glfwPlatformRestoreWindow(_GLFWwindow* window)
 {
+    if (window->null.iconified)
+    {
+        window->null.iconified = GLFW_FALSE;
+        _glfwInputWindowIconify(window, GLFW_FALSE);
+
+        if (window->monitor)
+        {
+            acquireMonitor(window);
+            fitToMonitor(window);
+        }
+    }
+    else if (window->null.maximized)
+    {
+        window->null.maximized = GLFW_FALSE;
+        _glfwInputWindowMaximize(window, GLFW_FALSE);
+    }
 }
 
 void _glfwPlatformMaximizeWindow(_GLFWwindow* window)
 {
+    if (window->null.maximized)
+        return;
+
+    window->null.maximized = GLFW_TRUE;
+    _glfwInputWindowMaximize(window, GLFW_TRUE);
 }
 
 int _glfwPlatformWindowMaximized(_GLFWwindow* window)
 {
-    return GLFW_FALSE;
+    return window->null.maximized;
 }
 
 int _glfwPlatformWindowHovered(_GLFWwindow* window)
 {
-    return GLFW_FALSE;
+    return window->null.hovered;
 }
 
 int _glfwPlatformFramebufferTransparent(_GLFWwindow* window)
 {
-    return GLFW_FALSE;
+    return window->null.transparent;
 }
 
 void _glfwPlatformSetWindowResizable(_GLFWwindow* window, GLFWbool enabled)
 {
+    window->null.resizable = enabled;
 }
 
 void _glfwPlatformSetWindowDecorated(_GLFWwindow* window, GLFWbool enabled)
 {
+    window->null.decorated = enabled;
 }
 
 void _glfwPlatformSetWindowFloating(_GLFWwindow* window, GLFWbool enabled)
 {
+    window->null.floating = enabled;
 }
 
 float _glfwPlatformGetWindowOpacity(_GLFWwindow* window)
 {
-    return 1.f;
+    return window->null.opacity;
 }
 
 void _glfwPlatformSetWindowOpacity(_GLFWwindow* window, float opacity)
 {
+    window->null.opacity = opacity;
 }
 
 void _glfwPlatformSetRawMouseMotion(_GLFWwindow *window, GLFWbool enabled)
@@ -207,66 +778,118 @@ GLFWbool _glfwPlatformRawMouseMotionSupported(void)
 
 void _glfwPlatformShowWindow(_GLFWwindow* window)
 {
+    window->null.visible = GLFW_TRUE;
 }
 
-
 void _glfwPlatformRequestWindowAttention(_GLFWwindow* window)
 {
 }
 
-void _glfwPlatformUnhideWindow(_GLFWwindow* window)
-{
-}
-
 void _glfwPlatformHideWindow(_GLFWwindow* window)
 {
+    unfocusWindow(window);
+    window->null.visible = GLFW_FALSE;
 }
 
 void _glfwPlatformFocusWindow(_GLFWwindow* window)
 {
+    _GLFWwindow* previous;
+
+    if (_glfw.null.focusedWindow == window)
+        return;
+
+    if (!window->null.visible)
+        return;
+
+    previous = _glfw.null.focusedWindow;
+    if (previous)
+        unfocusWindow(previous);
+
+    _glfw.null.focusedWindow = window;
+    _glfwInputWindowFocus(window, GLFW_TRUE);
 }
 
 int _glfwPlatformWindowFocused(_GLFWwindow* window)
 {
-    return GLFW_FALSE;
+    return _glfw.null.focusedWindow == window;
 }
 
 int _glfwPlatformWindowIconified(_GLFWwindow* window)
 {
-    return GLFW_FALSE;
+    return window->null.iconified;
 }
 
 int _glfwPlatformWindowVisible(_GLFWwindow* window)
 {
-    return GLFW_FALSE;
+    return window->null.visible;
 }
 
 void _glfwPlatformPollEvents(void)
 {
+    processEvents();
 }
 
 void _glfwPlatformWaitEvents(void)
 {
+    pthread_mutex_lock(&_glfw.null.eventLock);
+
+    while (!eventsPending())
+        pthread_cond_wait(&_glfw.null.eventCond, &_glfw.null.eventLock);
+
+    pthread_mutex_unlock(&_glfw.null.eventLock);
+
+    processEvents();
 }
 
 void _glfwPlatformWaitEventsTimeout(double timeout)
 {
+    struct timespec remaining;
+
+    // Timeouts this long are indistinguishable from waiting indefinitely
+    if (timeout > 1e9)
+    {
+        _glfwPlatformWaitEvents();
+        return;
+    }
+
+    remaining.tv_sec = (time_t) timeout;
+    remaining.tv_nsec = (long) ((timeout - remaining.tv_sec) * 1e9);
+    waitEventsFor(&remaining);
+}
+
+void _glfwPlatformWaitEventsUntil(uint64_t deadline)
+{
+    struct timespec remaining = { 0, 0 };
+    _glfwGetRemainingTimePOSIX(deadline, &remaining);
+    waitEventsFor(&remaining);
 }
 
 void _glfwPlatformPostEmptyEvent(void)
 {
+    pthread_mutex_lock(&_glfw.null.eventLock);
+    _glfw.null.emptyEventPosted = GLFW_TRUE;
+    pthread_cond_signal(&_glfw.null.eventCond);
+    pthread_mutex_unlock(&_glfw.null.eventLock);
 }
 
 void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
 {
+    if (xpos)
+        *xpos = window->null.cursorPosX;
+    if (ypos)
+        *ypos = window->null.cursorPosY;
 }
 
 void _glfwPlatformSetCursorPos(_GLFWwindow* window, double x, double y)
 {
+    window->null.cursorPosX = x;
+    window->null.cursorPosY = y;
 }
 
 void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
 {
+    if (mode == GLFW_CURSOR_DISABLED && _glfw.null.focusedWindow == window)
+        _glfwCenterCursorInContentArea(window);
 }
 
 int _glfwPlatformCreateCursor(_GLFWcursor* cursor,
@@ -291,32 +914,54 @@ void _glfwPlatformSetCursor(_GLFWwindow* window, _GLFWcursor* cursor)
 
 void _glfwPlatformSetClipboardString(const char* string)
 {
+    char* copy = _glfw_strdup(string);
+    _glfw_free(_glfw.null.clipboardString);
+    _glfw.null.clipboardString = copy;
 }
 
 const char* _glfwPlatformGetClipboardString(void)
 {
-    return NULL;
+    if (!_glfw.null.clipboardString)
+    {
+        _glfwInputError(GLFW_FORMAT_UNAVAILABLE,
+                        "Null: The clipboard is empty");
+    }
+
+    return _glfw.null.clipboardString;
 }
 
 const char* _glfwPlatformGetScancodeName(int scancode)
 {
-    return "";
+    if (scancode < 0 || scancode > GLFW_KEY_LAST)
+        return NULL;
+
+    if (!_glfw.null.keynames[scancode][0])
+        return NULL;
+
+    return _glfw.null.keynames[scancode];
 }
 
 int _glfwPlatformGetKeyScancode(int key)
 {
-    return -1;
+    return _glfw.null.scancodes[key];
 }
 
 void _glfwPlatformGetRequiredInstanceExtensions(char** extensions)
 {
+    if (!_glfw.vk.KHR_surface || !_glfw.vk.EXT_headless_surface)
+        return;
+
+    extensions[0] = "VK_KHR_surface";
+    extensions[1] = "VK_EXT_headless_surface";
 }
 
 int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
                                                       VkPhysicalDevice device,
                                                       uint32_t queuefamily)
 {
-    return GLFW_FALSE;
+    // Headless surfaces have no presentation support query and any queue
+    // family of a device supporting the extension can present to them
+    return GLFW_TRUE;
 }
 
 VkResult _glfwPlatformCreateWindowSurface(VkInstance instance,
@@ -324,7 +969,382 @@ VkResult _glfwPlatformCreateWindowSurface(VkInstance instance,
                                           const VkAllocationCallbacks* allocator,
                                           VkSurfaceKHR* surface)
 {
-    // This seems like the most appropriate error to return here
-    return VK_ERROR_INITIALIZATION_FAILED;
+    VkResult err;
+    VkHeadlessSurfaceCreateInfoEXT sci;
+    PFN_vkCreateHeadlessSurfaceEXT vkCreateHeadlessSurfaceEXT;
+
+    vkCreateHeadlessSurfaceEXT = (PFN_vkCreateHeadlessSurfaceEXT)
+        _glfwGetInstanceProcAddr(instance, "vkCreateHeadlessSurfaceEXT");
+    if (!vkCreateHeadlessSurfaceEXT)
+    {
+        _glfwInputError(GLFW_API_UNAVAILABLE,
+                        "Null: Vulkan instance missing VK_EXT_headless_surface extension");
+        return VK_ERROR_EXTENSION_NOT_PRESENT;
+    }
+
+    memset(&sci, 0, sizeof(sci));
+    sci.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+
+    err = vkCreateHeadlessSurfaceEXT(instance, &sci, allocator, surface);
+    if (err)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to create Vulkan surface: %s",
+                        _glfwGetVulkanResultString(err));
+    }
+
+    return err;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                        GLFW native API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWAPI void glfwNullInjectKey(GLFWwindow* handle,
+                               int key, int scancode, int action, int mods)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFWeventNull event = {0};
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (key != GLFW_KEY_UNKNOWN && (key < GLFW_KEY_SPACE || key > GLFW_KEY_LAST))
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid key %i", key);
+        return;
+    }
+
+    if (action != GLFW_PRESS && action != GLFW_RELEASE && action != GLFW_REPEAT)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid key action %i", action);
+        return;
+    }
+
+    if (scancode < 0 && key != GLFW_KEY_UNKNOWN)
+        scancode = _glfw.null.scancodes[key];
+
+    event.type = _GLFW_NULL_KEY_EVENT;
+    event.key = key;
+    event.scancode = scancode;
+    event.action = action;
+    event.mods = mods;
+    injectWindowEvent(window, &event);
+}
+
+GLFWAPI void glfwNullInjectChar(GLFWwindow* handle,
+                                unsigned int codepoint, int mods)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFWeventNull event = {0};
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    event.type = _GLFW_NULL_CHAR_EVENT;
+    event.codepoint = codepoint;
+    event.mods = mods;
+    injectWindowEvent(window, &event);
+}
+
+GLFWAPI void glfwNullInjectMouseButton(GLFWwindow* handle,
+                                       int button, int action, int mods)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFWeventNull event = {0};
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (button < GLFW_MOUSE_BUTTON_1 || button > GLFW_MOUSE_BUTTON_LAST)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid mouse button %i", button);
+        return;
+    }
+
+    if (action != GLFW_PRESS && action != GLFW_RELEASE)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM,
+                        "Invalid mouse button action %i", action);
+        return;
+    }
+
+    event.type = _GLFW_NULL_MOUSE_BUTTON_EVENT;
+    event.key = button;
+    event.action = action;
+    event.mods = mods;
+    injectWindowEvent(window, &event);
+}
+
+GLFWAPI void glfwNullInjectCursorPos(GLFWwindow* handle,
+                                     double xpos, double ypos)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFWeventNull event = {0};
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (xpos != xpos || xpos < -DBL_MAX || xpos > DBL_MAX ||
+        ypos != ypos || ypos < -DBL_MAX || ypos > DBL_MAX)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid cursor position %f %f",
+                        xpos, ypos);
+        return;
+    }
+
+    event.type = _GLFW_NULL_CURSOR_POS_EVENT;
+    event.x = xpos;
+    event.y = ypos;
+    injectWindowEvent(window, &event);
+}
+
+GLFWAPI void glfwNullInjectCursorEnter(GLFWwindow* handle, int entered)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFWeventNull event = {0};
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    event.type = _GLFW_NULL_CURSOR_ENTER_EVENT;
+    event.key = entered ? GLFW_TRUE : GLFW_FALSE;
+    injectWindowEvent(window, &event);
+}
+
+GLFWAPI void glfwNullInjectScroll(GLFWwindow* handle,
+                                  double xoffset, double yoffset)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFWeventNull event = {0};
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    event.type = _GLFW_NULL_SCROLL_EVENT;
+    event.x = xoffset;
+    event.y = yoffset;
+    injectWindowEvent(window, &event);
+}
+
+GLFWAPI void glfwNullInjectWindowPos(GLFWwindow* handle, int xpos, int ypos)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFWeventNull event = {0};
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    event.type = _GLFW_NULL_WINDOW_POS_EVENT;
+    event.x = xpos;
+    event.y = ypos;
+    injectWindowEvent(window, &event);
+}
+
+GLFWAPI void glfwNullInjectWindowSize(GLFWwindow* handle, int width, int height)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFWeventNull event = {0};
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (width <= 0 || height <= 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Invalid window size %ix%i",
+                        width, height);
+        return;
+    }
+
+    event.type = _GLFW_NULL_WINDOW_SIZE_EVENT;
+    event.x = width;
+    event.y = height;
+    injectWindowEvent(window, &event);
+}
+
+GLFWAPI void glfwNullInjectWindowFocus(GLFWwindow* handle, int focused)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFWeventNull event = {0};
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    event.type = _GLFW_NULL_WINDOW_FOCUS_EVENT;
+    event.key = focused ? GLFW_TRUE : GLFW_FALSE;
+    injectWindowEvent(window, &event);
+}
+
+GLFWAPI void glfwNullInjectWindowIconify(GLFWwindow* handle, int iconified)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFWeventNull event = {0};
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    event.type = _GLFW_NULL_WINDOW_ICONIFY_EVENT;
+    event.key = iconified ? GLFW_TRUE : GLFW_FALSE;
+    injectWindowEvent(window, &event);
+}
+
+GLFWAPI void glfwNullInjectWindowClose(GLFWwindow* handle)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    _GLFWeventNull event = {0};
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    event.type = _GLFW_NULL_WINDOW_CLOSE_EVENT;
+    injectWindowEvent(window, &event);
+}
+
+GLFWAPI void glfwNullInjectTimeStep(uint64_t delta)
+{
+    _GLFWeventNull event = {0};
+
+    _GLFW_REQUIRE_INIT();
+
+    if (!_glfw.hints.init.virtualClock)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "The virtual clock is not enabled");
+        return;
+    }
+
+    event.type = _GLFW_NULL_TIME_EVENT;
+    event.ticks = delta;
+    _glfwEnqueueEventNull(&event);
+}
+
+GLFWAPI unsigned char* glfwNullMapFramebuffer(GLFWwindow* handle,
+                                              int* width, int* height,
+                                              int* stride)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    if (width)
+        *width = 0;
+    if (height)
+        *height = 0;
+    if (stride)
+        *stride = 0;
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+
+    if (window->null.mapped)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "Null: Framebuffer is already mapped");
+        return NULL;
+    }
+
+    if (!resizeFramebuffer(window))
+        return NULL;
+
+    window->null.mapped = GLFW_TRUE;
+
+    if (width)
+        *width = window->null.pixelWidth;
+    if (height)
+        *height = window->null.pixelHeight;
+    if (stride)
+        *stride = window->null.pixelWidth * 4;
+
+    return window->null.pixels;
+}
+
+GLFWAPI void glfwNullUnmapFramebuffer(GLFWwindow* handle)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT();
+
+    if (!window->null.mapped)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Null: Framebuffer is not mapped");
+        return;
+    }
+
+    window->null.mapped = GLFW_FALSE;
+
+    if (window->null.framebufferCallback)
+    {
+        window->null.framebufferCallback(handle,
+                                         window->null.pixels,
+                                         window->null.pixelWidth,
+                                         window->null.pixelHeight,
+                                         window->null.pixelWidth * 4);
+    }
+
+    // The window may have been resized while the framebuffer was mapped
+    if (!window->null.mapped)
+        resizeFramebuffer(window);
+}
+
+GLFWAPI _GLFWnullframebufferfun glfwNullSetFramebufferCallback(GLFWwindow* handle,
+                                                               _GLFWnullframebufferfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(window->null.framebufferCallback, cbfun);
+    return cbfun;
+}
+
+GLFWAPI int glfwNullWriteFramebuffer(GLFWwindow* handle, const char* path)
+{
+    FILE* file;
+    int y;
+    GLFWbool result;
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(path != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!window->null.mapped && !resizeFramebuffer(window))
+        return GLFW_FALSE;
+
+    file = fopen(path, "wb");
+    if (!file)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to open %s for writing: %s",
+                        path, strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    fprintf(file,
+            "P7\nWIDTH %i\nHEIGHT %i\nDEPTH 4\nMAXVAL 255\n"
+            "TUPLTYPE RGB_ALPHA\nENDHDR\n",
+            window->null.pixelWidth, window->null.pixelHeight);
+
+    for (y = 0;  y < window->null.pixelHeight;  y++)
+    {
+        const size_t size = (size_t) window->null.pixelWidth * 4;
+        if (fwrite(window->null.pixels + y * size, 1, size, file) != size)
+            break;
+    }
+
+    result = !ferror(file);
+    if (fclose(file) != 0)
+        result = GLFW_FALSE;
+
+    if (!result)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Null: Failed to write framebuffer to %s", path);
+        return GLFW_FALSE;
+    }
+
+    return GLFW_TRUE;
 }
 
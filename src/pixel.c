@@ -0,0 +1,333 @@
+//========================================================================
+// GLFW 3.3 - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2006-2016 Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+#include "internal.h"
+
+#if defined(__AVX2__)
+ #define _GLFW_PIXEL_AVX2
+ #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define _GLFW_PIXEL_SSE2
+ #include <emmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && !defined(__ARM_BIG_ENDIAN)
+ #define _GLFW_PIXEL_NEON
+ #include <arm_neon.h>
+#endif
+
+// These kernels convert the RGBA byte order of GLFWimage pixels into native
+// endian 32-bit ARGB values, the format used for icons and cursors by most
+// window systems.  Each has a scalar version that also handles the pixels left
+// over by the vector version selected at compile time.
+//
+// Premultiplication is exact, i.e. it matches (c * a) / 255 with integer
+// division.  Both (p * 0x8081) >> 23 and (p + (p >> 8) + 1) >> 8 give that
+// result for every product p of two 8-bit values.
+
+// Number of pixels converted at a time when widening to long
+//
+#define _GLFW_PIXEL_CHUNK_SIZE 256
+
+
+static void swizzleScalar(uint32_t* target,
+                          const unsigned char* source,
+                          size_t count)
+{
+    size_t i;
+
+    for (i = 0;  i < count;  i++, source += 4)
+    {
+        target[i] = ((uint32_t) source[3] << 24) |
+                    ((uint32_t) source[0] << 16) |
+                    ((uint32_t) source[1] <<  8) |
+                    ((uint32_t) source[2] <<  0);
+    }
+}
+
+static void premultiplyScalar(uint32_t* target,
+                              const unsigned char* source,
+                              size_t count)
+{
+    size_t i;
+
+    for (i = 0;  i < count;  i++, source += 4)
+    {
+        const uint32_t alpha = source[3];
+
+        target[i] = (alpha << 24) |
+                    (((source[0] * alpha * 0x8081u) >> 23) << 16) |
+                    (((source[1] * alpha * 0x8081u) >> 23) <<  8) |
+                    (((source[2] * alpha * 0x8081u) >> 23) <<  0);
+    }
+}
+
+#if defined(_GLFW_PIXEL_SSE2)
+
+// Swaps the red and blue channels of four RGBA pixels
+//
+static __m128i swizzleSSE2(__m128i x)
+{
+    const __m128i ga = _mm_set1_epi32((int) 0xff00ff00);
+    const __m128i low = _mm_set1_epi32(0xff);
+    const __m128i r = _mm_slli_epi32(_mm_and_si128(x, low), 16);
+    const __m128i b = _mm_and_si128(_mm_srli_epi32(x, 16), low);
+
+    return _mm_or_si128(_mm_and_si128(x, ga), _mm_or_si128(r, b));
+}
+
+// Premultiplies two RGBA pixels widened to 16 bits and reorders them to BGRA
+//
+static __m128i premultiplySSE2(__m128i x)
+{
+    const __m128i alphaMask = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+    const __m128i alphaOne = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i divisor = _mm_set1_epi16((short) 0x8081);
+    __m128i alpha;
+
+    alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xff), 0xff);
+    alpha = _mm_or_si128(_mm_andnot_si128(alphaMask, alpha), alphaOne);
+
+    x = _mm_mullo_epi16(x, alpha);
+    x = _mm_srli_epi16(_mm_mulhi_epu16(x, divisor), 7);
+
+    return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(3, 0, 1, 2)),
+                               _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+static size_t swizzleVector(uint32_t* target,
+                            const unsigned char* source,
+                            size_t count)
+{
+    size_t i;
+
+    for (i = 0;  i + 4 <= count;  i += 4)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*) (source + i * 4));
+        _mm_storeu_si128((__m128i*) (target + i), swizzleSSE2(x));
+    }
+
+    return i;
+}
+
+static size_t premultiplyVector(uint32_t* target,
+                                const unsigned char* source,
+                                size_t count)
+{
+    const __m128i zero = _mm_setzero_si128();
+    size_t i;
+
+    for (i = 0;  i + 4 <= count;  i += 4)
+    {
+        const __m128i x = _mm_loadu_si128((const __m128i*) (source + i * 4));
+        const __m128i lo = premultiplySSE2(_mm_unpacklo_epi8(x, zero));
+        const __m128i hi = premultiplySSE2(_mm_unpackhi_epi8(x, zero));
+        _mm_storeu_si128((__m128i*) (target + i), _mm_packus_epi16(lo, hi));
+    }
+
+    return i;
+}
+
+#elif defined(_GLFW_PIXEL_AVX2)
+
+// Premultiplies four RGBA pixels widened to 16 bits and reorders them to BGRA
+//
+static __m256i premultiplyAVX2(__m256i x)
+{
+    const __m256i alphaMask = _mm256_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0,
+                                               -1, 0, 0, 0, -1, 0, 0, 0);
+    const __m256i alphaOne = _mm256_set_epi16(255, 0, 0, 0, 255, 0, 0, 0,
+                                              255, 0, 0, 0, 255, 0, 0, 0);
+    const __m256i divisor = _mm256_set1_epi16((short) 0x8081);
+    __m256i alpha;
+
+    alpha = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, 0xff), 0xff);
+    alpha = _mm256_or_si256(_mm256_andnot_si256(alphaMask, alpha), alphaOne);
+
+    x = _mm256_mullo_epi16(x, alpha);
+    x = _mm256_srli_epi16(_mm256_mulhi_epu16(x, divisor), 7);
+
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(x, _MM_SHUFFLE(3, 0, 1, 2)),
+                                  _MM_SHUFFLE(3, 0, 1, 2));
+}
+
+static size_t swizzleVector(uint32_t* target,
+                            const unsigned char* source,
+                            size_t count)
+{
+    const __m256i order = _mm256_set_epi8(15, 12, 13, 14, 11, 8, 9, 10,
+                                          7, 4, 5, 6, 3, 0, 1, 2,
+                                          15, 12, 13, 14, 11, 8, 9, 10,
+                                          7, 4, 5, 6, 3, 0, 1, 2);
+    size_t i;
+
+    for (i = 0;  i + 8 <= count;  i += 8)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*) (source + i * 4));
+        _mm256_storeu_si256((__m256i*) (target + i),
+                            _mm256_shuffle_epi8(x, order));
+    }
+
+    return i;
+}
+
+static size_t premultiplyVector(uint32_t* target,
+                                const unsigned char* source,
+                                size_t count)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    size_t i;
+
+    // The unpack and pack instructions work within each 128-bit lane, so the
+    // pixels end up back in their original order
+    for (i = 0;  i + 8 <= count;  i += 8)
+    {
+        const __m256i x = _mm256_loadu_si256((const __m256i*) (source + i * 4));
+        const __m256i lo = premultiplyAVX2(_mm256_unpacklo_epi8(x, zero));
+        const __m256i hi = premultiplyAVX2(_mm256_unpackhi_epi8(x, zero));
+        _mm256_storeu_si256((__m256i*) (target + i),
+                            _mm256_packus_epi16(lo, hi));
+    }
+
+    return i;
+}
+
+#elif defined(_GLFW_PIXEL_NEON)
+
+// Divides the specified products of two 8-bit values by 255
+//
+static uint8x8_t divide255NEON(uint16x8_t p)
+{
+    const uint16x8_t one = vdupq_n_u16(1);
+    return vshrn_n_u16(vaddq_u16(vsraq_n_u16(p, p, 8), one), 8);
+}
+
+static size_t swizzleVector(uint32_t* target,
+                            const unsigned char* source,
+                            size_t count)
+{
+    size_t i;
+
+    for (i = 0;  i + 16 <= count;  i += 16)
+    {
+        const uint8x16x4_t x = vld4q_u8(source + i * 4);
+        uint8x16x4_t y;
+
+        y.val[0] = x.val[2];
+        y.val[1] = x.val[1];
+        y.val[2] = x.val[0];
+        y.val[3] = x.val[3];
+
+        vst4q_u8((uint8_t*) (target + i), y);
+    }
+
+    return i;
+}
+
+static size_t premultiplyVector(uint32_t* target,
+                                const unsigned char* source,
+                                size_t count)
+{
+    size_t i;
+
+    for (i = 0;  i + 8 <= count;  i += 8)
+    {
+        const uint8x8x4_t x = vld4_u8(source + i * 4);
+        uint8x8x4_t y;
+
+        y.val[0] = divide255NEON(vmull_u8(x.val[2], x.val[3]));
+        y.val[1] = divide255NEON(vmull_u8(x.val[1], x.val[3]));
+        y.val[2] = divide255NEON(vmull_u8(x.val[0], x.val[3]));
+        y.val[3] = x.val[3];
+
+        vst4_u8((uint8_t*) (target + i), y);
+    }
+
+    return i;
+}
+
+#endif
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Converts RGBA pixels to 32-bit ARGB
+//
+void _glfwSwizzlePixelsARGB(uint32_t* target,
+                            const unsigned char* source,
+                            size_t count)
+{
+    size_t done = 0;
+
+#if defined(_GLFW_PIXEL_SSE2) || defined(_GLFW_PIXEL_AVX2) || \
+    defined(_GLFW_PIXEL_NEON)
+    done = swizzleVector(target, source, count);
+#endif
+
+    swizzleScalar(target + done, source + done * 4, count - done);
+}
+
+// Converts RGBA pixels to 32-bit ARGB with premultiplied alpha
+//
+void _glfwPremultiplyPixelsARGB(uint32_t* target,
+                                const unsigned char* source,
+                                size_t count)
+{
+    size_t done = 0;
+
+#if defined(_GLFW_PIXEL_SSE2) || defined(_GLFW_PIXEL_AVX2) || \
+    defined(_GLFW_PIXEL_NEON)
+    done = premultiplyVector(target, source, count);
+#endif
+
+    premultiplyScalar(target + done, source + done * 4, count - done);
+}
+
+// Converts RGBA pixels to 32-bit ARGB stored in longs, as used by X11
+//
+void _glfwWidenPixelsARGB(long* target,
+                          const unsigned char* source,
+                          size_t count)
+{
+    uint32_t chunk[_GLFW_PIXEL_CHUNK_SIZE];
+
+    while (count)
+    {
+        size_t i;
+        const size_t size = count < _GLFW_PIXEL_CHUNK_SIZE ?
+                            count : _GLFW_PIXEL_CHUNK_SIZE;
+
+        _glfwSwizzlePixelsARGB(chunk, source, size);
+
+        for (i = 0;  i < size;  i++)
+            target[i] = (long) chunk[i];
+
+        target += size;
+        source += size * 4;
+        count -= size;
+    }
+}
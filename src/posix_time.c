@@ -30,6 +30,100 @@
 #include <sys/time.h>
 #include <time.h>
 
+#if (defined(__i386__) || defined(__x86_64__)) && \
+    (defined(__GNUC__) || defined(__clang__)) && defined(CLOCK_MONOTONIC)
+ #define _GLFW_HAS_TSC
+ #include <cpuid.h>
+ #include <stdio.h>
+ #include <string.h>
+ #include <x86intrin.h>
+#endif
+
+#if defined(_GLFW_HAS_TSC)
+
+static uint64_t getMonotonicTime(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t) ts.tv_sec * (uint64_t) 1000000000 + (uint64_t) ts.tv_nsec;
+}
+
+// Returns whether the CPU has a TSC that runs at a constant rate in all
+// power states and the kernel trusts it enough to use it as its clock source,
+// which means it is also synchronized between cores
+//
+static GLFWbool isTSCReliable(void)
+{
+    unsigned int eax, ebx, ecx, edx;
+    char name[32] = "";
+    FILE* file;
+
+    if (!__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) || eax < 0x80000007)
+        return GLFW_FALSE;
+
+    __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx);
+    if (!(edx & (1 << 8)))
+        return GLFW_FALSE;
+
+    file = fopen("/sys/devices/system/clocksource/clocksource0/current_clocksource", "r");
+    if (!file)
+        return GLFW_FALSE;
+
+    if (!fgets(name, sizeof(name), file))
+        name[0] = '\0';
+
+    fclose(file);
+    return strcmp(name, "tsc\n") == 0;
+}
+
+// Measures the TSC frequency, in Hz, over the specified monotonic interval
+//
+static uint64_t measureTSCFrequency(uint64_t interval)
+{
+    uint64_t start, end, now, tscStart, tscEnd;
+
+    tscStart = __rdtsc();
+    start = getMonotonicTime();
+    end = start + interval;
+
+    do
+        now = getMonotonicTime();
+    while (now < end);
+
+    tscEnd = __rdtsc();
+
+    if (tscEnd <= tscStart)
+        return 0;
+
+    return (uint64_t) ((double) (tscEnd - tscStart) * 1e9 / (double) (now - start));
+}
+
+// Calibrates the TSC against the monotonic clock
+// Two measurements must agree to within 0.1% for the TSC to be used
+//
+static GLFWbool initTSC(void)
+{
+    uint64_t first, second;
+
+    if (!isTSCReliable())
+        return GLFW_FALSE;
+
+    first = measureTSCFrequency(5000000);
+    second = measureTSCFrequency(5000000);
+
+    if (first < 100000000 || second < 100000000)
+        return GLFW_FALSE;
+
+    if ((first > second ? first - second : second - first) > first / 1000)
+        return GLFW_FALSE;
+
+    _glfw.timer.posix.tsc = GLFW_TRUE;
+    _glfw.timer.posix.frequency = (first + second) / 2;
+    return GLFW_TRUE;
+}
+
+#endif // _GLFW_HAS_TSC
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -37,11 +131,18 @@
 
 // Initialise timer
 //
-void _glfwInitTimerPOSIX(void)
+void _glfwPlatformInitTimer(void)
 {
 #if defined(CLOCK_MONOTONIC)
     struct timespec ts;
+#endif
 
+#if defined(_GLFW_HAS_TSC)
+    if (_glfw.hints.init.tscTimer && initTSC())
+        return;
+#endif
+
+#if defined(CLOCK_MONOTONIC)
     if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0)
     {
         _glfw.timer.posix.monotonic = GLFW_TRUE;
@@ -55,6 +156,25 @@ void _glfwInitTimerPOSIX(void)
     }
 }
 
+// Returns the time remaining until the specified timer value, or GLFW_FALSE if
+// it has already been reached
+//
+GLFWbool _glfwGetRemainingTimePOSIX(uint64_t deadline, struct timespec* remaining)
+{
+    const uint64_t frequency = _glfw.timer.posix.frequency;
+    const uint64_t now = _glfwPlatformGetTimerValue();
+    uint64_t ticks;
+
+    if (deadline <= now)
+        return GLFW_FALSE;
+
+    ticks = deadline - now;
+    remaining->tv_sec = (time_t) (ticks / frequency);
+    remaining->tv_nsec = (long) ((ticks % frequency) * 1000000000 / frequency);
+    return GLFW_TRUE;
+}
+
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW platform API                      //////
@@ -62,6 +182,11 @@ void _glfwInitTimerPOSIX(void)
 
 uint64_t _glfwPlatformGetTimerValue(void)
 {
+#if defined(_GLFW_HAS_TSC)
+    if (_glfw.timer.posix.tsc)
+        return __rdtsc();
+#endif
+
 #if defined(CLOCK_MONOTONIC)
     if (_glfw.timer.posix.monotonic)
     {
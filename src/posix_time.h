@@ -28,6 +28,7 @@
 #define _GLFW_PLATFORM_LIBRARY_TIMER_STATE _GLFWtimerPOSIX posix
 
 #include <stdint.h>
+#include <time.h>
 
 
 // POSIX-specific global timer data
@@ -35,10 +36,12 @@
 typedef struct _GLFWtimerPOSIX
 {
     GLFWbool    monotonic;
+    // Whether the timer reads the invariant TSC directly
+    GLFWbool    tsc;
     uint64_t    frequency;
 
 } _GLFWtimerPOSIX;
 
 
-void _glfwInitTimerPOSIX(void);
+GLFWbool _glfwGetRemainingTimePOSIX(uint64_t deadline, struct timespec* remaining);
 
@@ -0,0 +1,815 @@
+//========================================================================
+// GLFW 3.3 - www.glfw.org
+//------------------------------------------------------------------------
+// Copyright (c) 2006-2016 Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+
+#include "internal.h"
+
+#include <assert.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// An input trace starts with the magic string and version, followed by the
+// frequency of the timer used for the timestamps as a varint.
+//
+// Each event then starts with a type byte, the number of timer units since the
+// previous event as a varint and, unless it is a sync, the serial number of the
+// window as a varint.  Integer arguments are stored as zigzag varints.  Motion
+// coordinates are stored as 24.8 fixed-point zigzag varints, as differences
+// from the previous position for cursor motion, unless they cannot be
+// represented exactly, in which case the raw flag is set on the type byte and
+// they are stored as little-endian IEEE 754 doubles.
+//
+#define _GLFW_TRACE_MAGIC       "GLFWTRC"
+#define _GLFW_TRACE_VERSION     1
+#define _GLFW_TRACE_RAW         0x80
+#define _GLFW_TRACE_BUFFER_SIZE 65536
+// The largest encoded size of an event other than a file drop
+#define _GLFW_TRACE_EVENT_SIZE  64
+
+// The number of integer arguments of each event type
+//
+static const int argCounts[] =
+{
+    0, // sync
+    4, // key
+    3, // char
+    3, // mouse button
+    0, // cursor pos
+    1, // cursor enter
+    0, // scroll
+    0, // drop
+    2, // window pos
+    2, // window size
+    2, // framebuffer size
+    0, // content scale
+    1, // window focus
+    1, // window iconify
+    1, // window maximize
+    0, // window damage
+    0  // window close
+};
+
+// Input recorder structure
+//
+struct _GLFWrecorder
+{
+    FILE*           file;
+    GLFWbool        failed;
+    // Whether any events have been written since the last sync
+    GLFWbool        unsynced;
+    uint64_t        time;
+    int64_t         cursorX, cursorY;
+    size_t          size;
+    unsigned char   buffer[_GLFW_TRACE_BUFFER_SIZE];
+};
+
+// Input replayer structure
+//
+struct _GLFWreplayer
+{
+    FILE*           file;
+    int             mode;
+    uint64_t        frequency;
+    uint64_t        start;
+    // Trace time and type of the next event, or -1 if none has been read
+    uint64_t        time;
+    int             type;
+    int64_t         cursorX, cursorY;
+    size_t          size;
+    size_t          offset;
+    unsigned char   buffer[_GLFW_TRACE_BUFFER_SIZE];
+};
+
+static uint64_t encodeSigned(int64_t value)
+{
+    return ((uint64_t) value << 1) ^ (uint64_t) (value >> 63);
+}
+
+static int64_t decodeSigned(uint64_t value)
+{
+    return (int64_t) (value >> 1) ^ -(int64_t) (value & 1);
+}
+
+// Converts a motion coordinate to 24.8 fixed-point, if it can be represented
+// exactly
+//
+static GLFWbool toFixed(double value, int64_t* result)
+{
+    const double scaled = value * 256.0;
+
+    if (scaled != scaled || scaled < -4503599627370496.0 ||
+        scaled > 4503599627370496.0)
+    {
+        return GLFW_FALSE;
+    }
+
+    *result = (int64_t) scaled;
+    return (double) *result == scaled;
+}
+
+static unsigned char* putVarint(unsigned char* p, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        *p++ = (unsigned char) (value | 0x80);
+        value >>= 7;
+    }
+
+    *p++ = (unsigned char) value;
+    return p;
+}
+
+static unsigned char* putDouble(unsigned char* p, double value)
+{
+    uint64_t bits;
+    int i;
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    for (i = 0;  i < 8;  i++)
+        *p++ = (unsigned char) (bits >> (i * 8));
+
+    return p;
+}
+
+// Writes the contents of the recorder buffer to the trace file
+//
+static void flushRecorder(_GLFWrecorder* recorder)
+{
+    if (!recorder->failed && recorder->size)
+    {
+        if (fwrite(recorder->buffer, 1, recorder->size, recorder->file) !=
+            recorder->size)
+        {
+            _glfwInputError(GLFW_PLATFORM_ERROR,
+                            "Failed to write input trace: %s",
+                            strerror(errno));
+            recorder->failed = GLFW_TRUE;
+        }
+    }
+
+    recorder->size = 0;
+}
+
+// Writes the header of an event and returns where to write its arguments
+//
+static unsigned char* beginEvent(int type, _GLFWwindow* window)
+{
+    _GLFWrecorder* recorder = _glfw.recorder;
+    const uint64_t time = _glfwGetTimerValue();
+    unsigned char* p;
+
+    if (recorder->size > _GLFW_TRACE_BUFFER_SIZE - _GLFW_TRACE_EVENT_SIZE)
+        flushRecorder(recorder);
+
+    p = recorder->buffer + recorder->size;
+    *p++ = (unsigned char) type;
+
+    if (time > recorder->time)
+    {
+        p = putVarint(p, time - recorder->time);
+        recorder->time = time;
+    }
+    else
+        p = putVarint(p, 0);
+
+    if (window)
+    {
+        p = putVarint(p, window->serial);
+        recorder->unsynced = GLFW_TRUE;
+    }
+
+    return p;
+}
+
+static void endEvent(unsigned char* p)
+{
+    _glfw.recorder->size = p - _glfw.recorder->buffer;
+}
+
+// Writes data of any size to the recorder buffer
+//
+static void writeBytes(const void* data, size_t size)
+{
+    _GLFWrecorder* recorder = _glfw.recorder;
+    const unsigned char* bytes = data;
+
+    while (size)
+    {
+        size_t count = _GLFW_TRACE_BUFFER_SIZE - recorder->size;
+        if (count > size)
+            count = size;
+
+        memcpy(recorder->buffer + recorder->size, bytes, count);
+        recorder->size += count;
+        bytes += count;
+        size -= count;
+
+        if (recorder->size == _GLFW_TRACE_BUFFER_SIZE)
+            flushRecorder(recorder);
+    }
+}
+
+// Refills the replayer buffer and returns the next byte of the trace
+//
+static GLFWbool readByte(_GLFWreplayer* replayer, unsigned char* result)
+{
+    if (replayer->offset == replayer->size)
+    {
+        replayer->offset = 0;
+        replayer->size = fread(replayer->buffer, 1,
+                               _GLFW_TRACE_BUFFER_SIZE,
+                               replayer->file);
+        if (!replayer->size)
+            return GLFW_FALSE;
+    }
+
+    *result = replayer->buffer[replayer->offset++];
+    return GLFW_TRUE;
+}
+
+static GLFWbool readVarint(_GLFWreplayer* replayer, uint64_t* result)
+{
+    int shift;
+
+    *result = 0;
+
+    for (shift = 0;  shift < 64;  shift += 7)
+    {
+        unsigned char byte;
+        if (!readByte(replayer, &byte))
+            return GLFW_FALSE;
+
+        *result |= (uint64_t) (byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return GLFW_TRUE;
+    }
+
+    return GLFW_FALSE;
+}
+
+static GLFWbool readSigned(_GLFWreplayer* replayer, int64_t* result)
+{
+    uint64_t value;
+
+    if (!readVarint(replayer, &value))
+        return GLFW_FALSE;
+
+    *result = decodeSigned(value);
+    return GLFW_TRUE;
+}
+
+static GLFWbool readDouble(_GLFWreplayer* replayer, double* result)
+{
+    uint64_t bits = 0;
+    int i;
+
+    for (i = 0;  i < 8;  i++)
+    {
+        unsigned char byte;
+        if (!readByte(replayer, &byte))
+            return GLFW_FALSE;
+
+        bits |= (uint64_t) byte << (i * 8);
+    }
+
+    memcpy(result, &bits, sizeof(bits));
+    return GLFW_TRUE;
+}
+
+// Reads the coordinates of a motion event
+//
+static GLFWbool readMotion(_GLFWreplayer* replayer,
+                           int type, GLFWbool raw,
+                           double* x, double* y)
+{
+    int64_t fx, fy;
+
+    if (raw)
+        return readDouble(replayer, x) && readDouble(replayer, y);
+
+    if (!readSigned(replayer, &fx) || !readSigned(replayer, &fy))
+        return GLFW_FALSE;
+
+    if (type == _GLFW_RECORD_CURSOR_POS)
+    {
+        replayer->cursorX += fx;
+        replayer->cursorY += fy;
+        fx = replayer->cursorX;
+        fy = replayer->cursorY;
+    }
+
+    *x = fx / 256.0;
+    *y = fy / 256.0;
+    return GLFW_TRUE;
+}
+
+// Reads the paths of a drop event and passes them on to the window, if any
+//
+static GLFWbool replayDrop(_GLFWreplayer* replayer, _GLFWwindow* window)
+{
+    uint64_t count, length;
+    char** paths;
+    uint64_t i, j;
+    GLFWbool result = GLFW_TRUE;
+
+    if (!readVarint(replayer, &count) || count > 65536)
+        return GLFW_FALSE;
+
+    paths = _glfw_calloc((size_t) count ? (size_t) count : 1, sizeof(char*));
+
+    for (i = 0;  i < count && result;  i++)
+    {
+        if (!readVarint(replayer, &length) || length > 65536)
+        {
+            result = GLFW_FALSE;
+            break;
+        }
+
+        paths[i] = _glfw_calloc((size_t) length + 1, 1);
+
+        for (j = 0;  j < length;  j++)
+        {
+            unsigned char c;
+            if (!readByte(replayer, &c))
+            {
+                result = GLFW_FALSE;
+                break;
+            }
+
+            paths[i][j] = (char) c;
+        }
+    }
+
+    if (result && window)
+        _glfwInputDrop(window, (int) count, (const char**) paths);
+
+    for (i = 0;  i < count;  i++)
+        _glfw_free(paths[i]);
+    _glfw_free(paths);
+
+    return result;
+}
+
+// Reads the type and time of the next event
+//
+static GLFWbool readEventHeader(_GLFWreplayer* replayer)
+{
+    unsigned char type;
+    uint64_t delta;
+
+    if (!readByte(replayer, &type) || !readVarint(replayer, &delta))
+        return GLFW_FALSE;
+
+    replayer->type = type;
+    replayer->time += delta;
+    return GLFW_TRUE;
+}
+
+// Reads the remainder of the current event and passes it on to its window
+//
+static GLFWbool replayEvent(_GLFWreplayer* replayer)
+{
+    const int type = replayer->type & ~_GLFW_TRACE_RAW;
+    const GLFWbool raw = (replayer->type & _GLFW_TRACE_RAW) != 0;
+    uint64_t serial;
+    _GLFWwindow* window;
+    int64_t args[4];
+    double x, y;
+    int i;
+
+    if (type > _GLFW_RECORD_WINDOW_CLOSE)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Invalid event type %i in input trace", type);
+        return GLFW_FALSE;
+    }
+
+    if (!readVarint(replayer, &serial))
+        return GLFW_FALSE;
+
+    for (i = 0;  i < argCounts[type];  i++)
+    {
+        if (!readSigned(replayer, args + i))
+            return GLFW_FALSE;
+    }
+
+    for (window = _glfw.windowListHead;  window;  window = window->next)
+    {
+        if (window->serial == serial)
+            break;
+    }
+
+    switch (type)
+    {
+        case _GLFW_RECORD_DROP:
+            return replayDrop(replayer, window);
+
+        case _GLFW_RECORD_CURSOR_POS:
+        case _GLFW_RECORD_SCROLL:
+        case _GLFW_RECORD_CONTENT_SCALE:
+            if (!readMotion(replayer, type, raw, &x, &y))
+                return GLFW_FALSE;
+            break;
+    }
+
+    // Events for windows that do not exist in this session are skipped
+    if (!window)
+        return GLFW_TRUE;
+
+    switch (type)
+    {
+        case _GLFW_RECORD_KEY:
+            _glfwInputKey(window,
+                          (int) args[0], (int) args[1],
+                          (int) args[2], (int) args[3]);
+            break;
+        case _GLFW_RECORD_CHAR:
+            _glfwInputChar(window,
+                           (unsigned int) args[0],
+                           (int) args[1], (GLFWbool) args[2]);
+            break;
+        case _GLFW_RECORD_MOUSE_BUTTON:
+            _glfwInputMouseClick(window,
+                                 (int) args[0], (int) args[1], (int) args[2]);
+            break;
+        case _GLFW_RECORD_CURSOR_POS:
+            _glfwInputCursorPos(window, x, y);
+            break;
+        case _GLFW_RECORD_CURSOR_ENTER:
+            _glfwInputCursorEnter(window, (GLFWbool) args[0]);
+            break;
+        case _GLFW_RECORD_SCROLL:
+            _glfwInputScroll(window, x, y);
+            break;
+        case _GLFW_RECORD_WINDOW_POS:
+            _glfwInputWindowPos(window, (int) args[0], (int) args[1]);
+            break;
+        case _GLFW_RECORD_WINDOW_SIZE:
+            _glfwInputWindowSize(window, (int) args[0], (int) args[1]);
+            break;
+        case _GLFW_RECORD_FRAMEBUFFER_SIZE:
+            _glfwInputFramebufferSize(window, (int) args[0], (int) args[1]);
+            break;
+        case _GLFW_RECORD_CONTENT_SCALE:
+            _glfwInputWindowContentScale(window, (float) x, (float) y);
+            break;
+        case _GLFW_RECORD_WINDOW_FOCUS:
+            _glfwInputWindowFocus(window, (GLFWbool) args[0]);
+            break;
+        case _GLFW_RECORD_WINDOW_ICONIFY:
+            _glfwInputWindowIconify(window, (GLFWbool) args[0]);
+            break;
+        case _GLFW_RECORD_WINDOW_MAXIMIZE:
+            _glfwInputWindowMaximize(window, (GLFWbool) args[0]);
+            break;
+        case _GLFW_RECORD_WINDOW_DAMAGE:
+            _glfwInputWindowDamage(window);
+            break;
+        case _GLFW_RECORD_WINDOW_CLOSE:
+            _glfwInputWindowCloseRequest(window);
+            break;
+    }
+
+    return GLFW_TRUE;
+}
+
+// Converts a trace time to the current timer
+//
+static uint64_t traceToTimer(const _GLFWreplayer* replayer, uint64_t time)
+{
+    const uint64_t frequency = _glfwGetTimerFrequency();
+
+    if (frequency == replayer->frequency)
+        return replayer->start + time;
+
+    return replayer->start +
+        (uint64_t) ((double) time * frequency / replayer->frequency);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                       GLFW internal API                      //////
+//////////////////////////////////////////////////////////////////////////
+
+// Records an event with integer arguments
+//
+void _glfwRecordEvent(int type, _GLFWwindow* window, int a, int b, int c, int d)
+{
+    const int64_t args[4] = { a, b, c, d };
+    unsigned char* p = beginEvent(type, window);
+    int i;
+
+    for (i = 0;  i < argCounts[type];  i++)
+        p = putVarint(p, encodeSigned(args[i]));
+
+    endEvent(p);
+}
+
+// Records a cursor motion, scroll or content scale event
+//
+void _glfwRecordMotion(int type, _GLFWwindow* window, double x, double y)
+{
+    _GLFWrecorder* recorder = _glfw.recorder;
+    int64_t fx, fy;
+    unsigned char* p;
+
+    if (toFixed(x, &fx) && toFixed(y, &fy))
+    {
+        p = beginEvent(type, window);
+
+        if (type == _GLFW_RECORD_CURSOR_POS)
+        {
+            p = putVarint(p, encodeSigned(fx - recorder->cursorX));
+            p = putVarint(p, encodeSigned(fy - recorder->cursorY));
+            recorder->cursorX = fx;
+            recorder->cursorY = fy;
+        }
+        else
+        {
+            p = putVarint(p, encodeSigned(fx));
+            p = putVarint(p, encodeSigned(fy));
+        }
+    }
+    else
+    {
+        p = beginEvent(type | _GLFW_TRACE_RAW, window);
+        p = putDouble(p, x);
+        p = putDouble(p, y);
+    }
+
+    endEvent(p);
+}
+
+// Records a file drop event
+//
+void _glfwRecordDrop(_GLFWwindow* window, int count, const char** paths)
+{
+    int i;
+    unsigned char* p = beginEvent(_GLFW_RECORD_DROP, window);
+    p = putVarint(p, count);
+    endEvent(p);
+
+    for (i = 0;  i < count;  i++)
+    {
+        const size_t length = strlen(paths[i]);
+        unsigned char header[10];
+        writeBytes(header, putVarint(header, length) - header);
+        writeBytes(paths[i], length);
+    }
+}
+
+// Records the end of an event processing call, if any events were recorded
+// since the previous one
+//
+void _glfwRecordSync(void)
+{
+    if (!_glfw.recorder->unsynced)
+        return;
+
+    endEvent(beginEvent(_GLFW_RECORD_SYNC, NULL));
+    _glfw.recorder->unsynced = GLFW_FALSE;
+}
+
+// Passes on the replayed events that are due
+//
+void _glfwReplayEvents(void)
+{
+    _GLFWreplayer* replayer = _glfw.replayer;
+
+    for (;;)
+    {
+        if (replayer->type == -1 && !readEventHeader(replayer))
+        {
+            glfwStopReplay();
+            return;
+        }
+
+        if (replayer->mode == GLFW_REPLAY_REALTIME)
+        {
+            if (traceToTimer(replayer, replayer->time) > _glfwGetTimerValue())
+                return;
+        }
+        else if (_glfw.hints.init.virtualClock)
+        {
+            const uint64_t time = traceToTimer(replayer, replayer->time);
+            if (time > _glfw.timer.virtualValue)
+                _glfwAdvanceTimer(time - _glfw.timer.virtualValue);
+        }
+
+        if (replayer->type == _GLFW_RECORD_SYNC)
+        {
+            replayer->type = -1;
+
+            // Fast replay delivers one recorded event processing call at a time
+            if (replayer->mode == GLFW_REPLAY_FAST)
+                return;
+
+            continue;
+        }
+
+        if (!replayEvent(replayer))
+        {
+            glfwStopReplay();
+            return;
+        }
+
+        // The replay may have been stopped by an event callback
+        if (_glfw.replayer != replayer)
+            return;
+
+        replayer->type = -1;
+    }
+}
+
+// Returns the time, in seconds, until the next replayed event is due
+//
+double _glfwGetReplayTimeout(void)
+{
+    _GLFWreplayer* replayer = _glfw.replayer;
+    uint64_t time, now;
+
+    if (replayer->mode == GLFW_REPLAY_FAST)
+        return 0.0;
+
+    if (replayer->type == -1 && !readEventHeader(replayer))
+        return 0.0;
+
+    time = traceToTimer(replayer, replayer->time);
+    now = _glfwGetTimerValue();
+    if (time <= now)
+        return 0.0;
+
+    return (double) (time - now) / _glfwGetTimerFrequency();
+}
+
+// Stops any recording or replay in progress
+//
+void _glfwTerminateRecording(void)
+{
+    glfwStopRecording();
+    glfwStopReplay();
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+//////                        GLFW public API                       //////
+//////////////////////////////////////////////////////////////////////////
+
+GLFWAPI int glfwStartRecording(const char* path)
+{
+    _GLFWrecorder* recorder;
+    unsigned char* p;
+    FILE* file;
+
+    assert(path != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    glfwStopRecording();
+
+    file = fopen(path, "wb");
+    if (!file)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Failed to open input trace %s: %s",
+                        path, strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    recorder = _glfw_calloc(1, sizeof(_GLFWrecorder));
+    recorder->file = file;
+    recorder->time = _glfwGetTimerValue();
+
+    p = recorder->buffer;
+    memcpy(p, _GLFW_TRACE_MAGIC, 7);
+    p += 7;
+    *p++ = _GLFW_TRACE_VERSION;
+    p = putVarint(p, _glfwGetTimerFrequency());
+    recorder->size = p - recorder->buffer;
+
+    _glfw.recorder = recorder;
+    return GLFW_TRUE;
+}
+
+GLFWAPI void glfwStopRecording(void)
+{
+    _GLFWrecorder* recorder;
+
+    _GLFW_REQUIRE_INIT();
+
+    recorder = _glfw.recorder;
+    if (!recorder)
+        return;
+
+    _glfw.recorder = NULL;
+
+    flushRecorder(recorder);
+    if (fclose(recorder->file) != 0 && !recorder->failed)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Failed to write input trace: %s",
+                        strerror(errno));
+    }
+
+    _glfw_free(recorder);
+}
+
+GLFWAPI int glfwStartReplay(const char* path, int mode)
+{
+    _GLFWreplayer* replayer;
+    unsigned char header[8];
+    FILE* file;
+
+    assert(path != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (mode != GLFW_REPLAY_REALTIME && mode != GLFW_REPLAY_FAST)
+    {
+        _glfwInputError(GLFW_INVALID_ENUM, "Invalid replay mode 0x%08X", mode);
+        return GLFW_FALSE;
+    }
+
+    glfwStopReplay();
+
+    file = fopen(path, "rb");
+    if (!file)
+    {
+        _glfwInputError(GLFW_PLATFORM_ERROR,
+                        "Failed to open input trace %s: %s",
+                        path, strerror(errno));
+        return GLFW_FALSE;
+    }
+
+    replayer = _glfw_calloc(1, sizeof(_GLFWreplayer));
+    replayer->file = file;
+    replayer->mode = mode;
+    replayer->type = -1;
+
+    if (fread(header, 1, sizeof(header), file) != sizeof(header) ||
+        memcmp(header, _GLFW_TRACE_MAGIC, 7) != 0 ||
+        header[7] != _GLFW_TRACE_VERSION ||
+        !readVarint(replayer, &replayer->frequency) ||
+        !replayer->frequency)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE,
+                        "File %s is not a supported input trace", path);
+
+        fclose(file);
+        _glfw_free(replayer);
+        return GLFW_FALSE;
+    }
+
+    replayer->start = _glfwGetTimerValue();
+
+    _glfw.replayer = replayer;
+    return GLFW_TRUE;
+}
+
+GLFWAPI void glfwStopReplay(void)
+{
+    _GLFWreplayer* replayer;
+
+    _GLFW_REQUIRE_INIT();
+
+    replayer = _glfw.replayer;
+    if (!replayer)
+        return;
+
+    _glfw.replayer = NULL;
+
+    fclose(replayer->file);
+    _glfw_free(replayer);
+}
+
+GLFWAPI int glfwReplayActive(void)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+    return _glfw.replayer != NULL;
+}
+
@@ -34,6 +34,139 @@
 #define _GLFW_FIND_LOADER    1
 #define _GLFW_REQUIRE_LOADER 2
 
+// Returns the hash of the specified entry point name
+//
+static uint32_t hashProcName(const char* name)
+{
+    uint32_t hash = 2166136261u;
+
+    while (*name)
+        hash = (hash ^ (unsigned char) *name++) * 16777619u;
+
+    return hash;
+}
+
+// Returns the cached entry for the specified instance and entry point name, or
+// the empty slot where it would be inserted
+//
+static _GLFWvkentry* findEntry(_GLFWvkentry* entries, uint32_t capacity,
+                               VkInstance instance, uint32_t hash,
+                               const char* name)
+{
+    const uint32_t mask = capacity - 1;
+    uint32_t i = (hash ^ (uint32_t) ((uintptr_t) instance >> 4)) & mask;
+
+    for (;;)
+    {
+        _GLFWvkentry* entry = entries + i;
+
+        if (!entry->name)
+            return entry;
+
+        if (entry->hash == hash &&
+            entry->instance == instance &&
+            strcmp(entry->name, name) == 0)
+        {
+            return entry;
+        }
+
+        i = (i + 1) & mask;
+    }
+}
+
+// Rebuilds the entry point table with the specified capacity, dropping the
+// entries of the specified instance
+//
+static void rebuildEntries(uint32_t capacity, GLFWbool discard, VkInstance instance)
+{
+    uint32_t i;
+    _GLFWvkentry* entries = _glfw_calloc(capacity, sizeof(_GLFWvkentry));
+
+    _glfw.vk.entryCount = 0;
+
+    for (i = 0;  i < _glfw.vk.entryCapacity;  i++)
+    {
+        _GLFWvkentry* entry = _glfw.vk.entries + i;
+
+        if (!entry->name)
+            continue;
+
+        if (discard && entry->instance == instance)
+        {
+            _glfw_free(entry->name);
+            continue;
+        }
+
+        *findEntry(entries, capacity,
+                   entry->instance, entry->hash, entry->name) = *entry;
+        _glfw.vk.entryCount++;
+    }
+
+    _glfw_free(_glfw.vk.entries);
+    _glfw.vk.entries = entries;
+    _glfw.vk.entryCapacity = capacity;
+}
+
+// Adds a resolved entry point to the cache
+//
+static void addEntry(VkInstance instance, uint32_t hash,
+                     const char* name, GLFWvkproc proc)
+{
+    _GLFWvkentry* entry;
+
+    // Keep the load factor at or below one half
+    if ((_glfw.vk.entryCount + 1) * 2 > _glfw.vk.entryCapacity)
+    {
+        const uint32_t capacity = _glfw.vk.entryCapacity ?
+                                  _glfw.vk.entryCapacity * 2 : 64;
+        rebuildEntries(capacity, GLFW_FALSE, VK_NULL_HANDLE);
+    }
+
+    entry = findEntry(_glfw.vk.entries, _glfw.vk.entryCapacity,
+                      instance, hash, name);
+    entry->instance = instance;
+    entry->hash = hash;
+    entry->name = _glfw_strdup(name);
+    entry->proc = proc;
+    _glfw.vk.entryCount++;
+}
+
+// Discards cached data for the specified instance, or all cached data
+//
+static void discardCache(GLFWbool all, VkInstance instance)
+{
+    int i, count = 0;
+
+    if (all)
+    {
+        uint32_t j;
+
+        for (j = 0;  j < _glfw.vk.entryCapacity;  j++)
+            _glfw_free(_glfw.vk.entries[j].name);
+
+        _glfw_free(_glfw.vk.entries);
+        _glfw.vk.entries = NULL;
+        _glfw.vk.entryCount = 0;
+        _glfw.vk.entryCapacity = 0;
+
+        _glfw_free(_glfw.vk.presents);
+        _glfw.vk.presents = NULL;
+        _glfw.vk.presentCount = 0;
+        return;
+    }
+
+    if (_glfw.vk.entryCapacity)
+        rebuildEntries(_glfw.vk.entryCapacity, GLFW_TRUE, instance);
+
+    for (i = 0;  i < _glfw.vk.presentCount;  i++)
+    {
+        if (_glfw.vk.presents[i].instance != instance)
+            _glfw.vk.presents[count++] = _glfw.vk.presents[i];
+    }
+
+    _glfw.vk.presentCount = count;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -104,7 +237,7 @@ GLFWbool _glfwInitVulkan(int mode)
         return GLFW_FALSE;
     }
 
-    ep = calloc(count, sizeof(VkExtensionProperties));
+    ep = _glfw_calloc(count, sizeof(VkExtensionProperties));
 
     err = vkEnumerateInstanceExtensionProperties(NULL, &count, ep);
     if (err)
@@ -113,7 +246,7 @@ GLFWbool _glfwInitVulkan(int mode)
                         "Vulkan: Failed to query instance extensions: %s",
                         _glfwGetVulkanResultString(err));
 
-        free(ep);
+        _glfw_free(ep);
         _glfwTerminateVulkan();
         return GLFW_FALSE;
     }
@@ -136,10 +269,13 @@ GLFWbool _glfwInitVulkan(int mode)
 #elif defined(_GLFW_WAYLAND)
         else if (strcmp(ep[i].extensionName, "VK_KHR_wayland_surface") == 0)
             _glfw.vk.KHR_wayland_surface = GLFW_TRUE;
+#elif defined(_GLFW_OSMESA)
+        else if (strcmp(ep[i].extensionName, "VK_EXT_headless_surface") == 0)
+            _glfw.vk.EXT_headless_surface = GLFW_TRUE;
 #endif
     }
 
-    free(ep);
+    _glfw_free(ep);
 
     _glfw.vk.available = GLFW_TRUE;
 
@@ -150,12 +286,76 @@ GLFWbool _glfwInitVulkan(int mode)
 
 void _glfwTerminateVulkan(void)
 {
+    discardCache(GLFW_TRUE, VK_NULL_HANDLE);
+
 #if !defined(_GLFW_VULKAN_STATIC)
     if (_glfw.vk.handle)
         _glfw_dlclose(_glfw.vk.handle);
 #endif
 }
 
+// Resolves the specified entry point, using the cache where possible
+//
+GLFWvkproc _glfwGetInstanceProcAddr(VkInstance instance, const char* procname)
+{
+    GLFWvkproc proc;
+    uint32_t hash = 0;
+    GLFWbool cache;
+
+    // Global entry points do not depend on any instance and are always cached
+    cache = instance == VK_NULL_HANDLE || _glfw.hints.init.vulkanCache;
+    if (cache)
+    {
+        hash = hashProcName(procname);
+
+        _glfwPlatformLockMutex(&_glfw.vk.lock);
+
+        if (_glfw.vk.entryCapacity)
+        {
+            const _GLFWvkentry* entry = findEntry(_glfw.vk.entries,
+                                                  _glfw.vk.entryCapacity,
+                                                  instance, hash, procname);
+            if (entry->name)
+            {
+                proc = entry->proc;
+                _glfwPlatformUnlockMutex(&_glfw.vk.lock);
+                return proc;
+            }
+        }
+
+        _glfwPlatformUnlockMutex(&_glfw.vk.lock);
+    }
+
+    proc = (GLFWvkproc) vkGetInstanceProcAddr(instance, procname);
+#if defined(_GLFW_VULKAN_STATIC)
+    if (!proc)
+    {
+        if (strcmp(procname, "vkGetInstanceProcAddr") == 0)
+            return (GLFWvkproc) vkGetInstanceProcAddr;
+    }
+#else
+    if (!proc)
+        proc = (GLFWvkproc) _glfw_dlsym(_glfw.vk.handle, procname);
+#endif
+
+    if (cache)
+    {
+        _glfwPlatformLockMutex(&_glfw.vk.lock);
+
+        // Another thread may have resolved the same entry point meanwhile
+        if (!_glfw.vk.entryCapacity ||
+            !findEntry(_glfw.vk.entries, _glfw.vk.entryCapacity,
+                       instance, hash, procname)->name)
+        {
+            addEntry(instance, hash, procname, proc);
+        }
+
+        _glfwPlatformUnlockMutex(&_glfw.vk.lock);
+    }
+
+    return proc;
+}
+
 const char* _glfwGetVulkanResultString(VkResult result)
 {
     switch (result)
@@ -243,7 +443,6 @@ GLFWAPI const char** glfwGetRequiredInstanceExtensions(uint32_t* count)
 GLFWAPI GLFWvkproc glfwGetInstanceProcAddress(VkInstance instance,
                                               const char* procname)
 {
-    GLFWvkproc proc;
     assert(procname != NULL);
 
     _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
@@ -251,25 +450,14 @@ GLFWAPI GLFWvkproc glfwGetInstanceProcAddress(VkInstance instance,
     if (!_glfwInitVulkan(_GLFW_REQUIRE_LOADER))
         return NULL;
 
-    proc = (GLFWvkproc) vkGetInstanceProcAddr(instance, procname);
-#if defined(_GLFW_VULKAN_STATIC)
-    if (!proc)
-    {
-        if (strcmp(procname, "vkGetInstanceProcAddr") == 0)
-            return (GLFWvkproc) vkGetInstanceProcAddr;
-    }
-#else
-    if (!proc)
-        proc = (GLFWvkproc) _glfw_dlsym(_glfw.vk.handle, procname);
-#endif
-
-    return proc;
+    return _glfwGetInstanceProcAddr(instance, procname);
 }
 
 GLFWAPI int glfwGetPhysicalDevicePresentationSupport(VkInstance instance,
                                                      VkPhysicalDevice device,
                                                      uint32_t queuefamily)
 {
+    int supported;
     assert(instance != VK_NULL_HANDLE);
     assert(device != VK_NULL_HANDLE);
 
@@ -285,9 +473,62 @@ GLFWAPI int glfwGetPhysicalDevicePresentationSupport(VkInstance instance,
         return GLFW_FALSE;
     }
 
-    return _glfwPlatformGetPhysicalDevicePresentationSupport(instance,
-                                                             device,
-                                                             queuefamily);
+    if (_glfw.hints.init.vulkanCache)
+    {
+        int i;
+
+        _glfwPlatformLockMutex(&_glfw.vk.lock);
+
+        for (i = 0;  i < _glfw.vk.presentCount;  i++)
+        {
+            const _GLFWvkpresent* present = _glfw.vk.presents + i;
+
+            if (present->instance == instance &&
+                present->device == device &&
+                present->queuefamily == queuefamily)
+            {
+                supported = present->supported;
+                _glfwPlatformUnlockMutex(&_glfw.vk.lock);
+                return supported;
+            }
+        }
+
+        _glfwPlatformUnlockMutex(&_glfw.vk.lock);
+    }
+
+    supported = _glfwPlatformGetPhysicalDevicePresentationSupport(instance,
+                                                                  device,
+                                                                  queuefamily);
+
+    if (_glfw.hints.init.vulkanCache)
+    {
+        _GLFWvkpresent* present;
+
+        _glfwPlatformLockMutex(&_glfw.vk.lock);
+
+        _glfw.vk.presents =
+            _glfw_realloc(_glfw.vk.presents,
+                          (_glfw.vk.presentCount + 1) * sizeof(_GLFWvkpresent));
+
+        present = _glfw.vk.presents + _glfw.vk.presentCount++;
+        present->instance = instance;
+        present->device = device;
+        present->queuefamily = queuefamily;
+        present->supported = supported;
+
+        _glfwPlatformUnlockMutex(&_glfw.vk.lock);
+    }
+
+    return supported;
+}
+
+GLFWAPI void glfwInvalidateVulkanCache(VkInstance instance)
+{
+    _GLFW_REQUIRE_INIT();
+
+    _glfwPlatformLockMutex(&_glfw.vk.lock);
+    discardCache(instance == VK_NULL_HANDLE, instance);
+    _glfwPlatformUnlockMutex(&_glfw.vk.lock);
 }
 
 GLFWAPI VkResult glfwCreateWindowSurface(VkInstance instance,
@@ -49,8 +49,6 @@ typedef struct _GLFWjoystickWin32
 } _GLFWjoystickWin32;
 
 
-void _glfwInitJoysticksWin32(void);
-void _glfwTerminateJoysticksWin32(void);
 void _glfwDetectJoystickConnectionWin32(void);
 void _glfwDetectJoystickDisconnectionWin32(void);
 
@@ -34,7 +34,7 @@
 
 // Initialise timer
 //
-void _glfwInitTimerWin32(void)
+void _glfwPlatformInitTimer(void)
 {
     uint64_t frequency;
 
@@ -33,6 +33,186 @@
 #include <stdlib.h>
 #include <float.h>
 
+#if defined(_MSC_VER)
+ #include <intrin.h>
+#endif
+
+
+#if defined(_MSC_VER)
+
+static unsigned int atomicLoad(unsigned int* value)
+{
+    return (unsigned int) _InterlockedCompareExchange((volatile long*) value, 0, 0);
+}
+
+static void atomicStore(unsigned int* value, unsigned int desired)
+{
+    _InterlockedExchange((volatile long*) value, (long) desired);
+}
+
+static unsigned int atomicExchange(unsigned int* value, unsigned int desired)
+{
+    return (unsigned int) _InterlockedExchange((volatile long*) value, (long) desired);
+}
+
+static GLFWbool atomicCompareExchange(unsigned int* value,
+                                      unsigned int* expected,
+                                      unsigned int desired)
+{
+    const unsigned int previous = (unsigned int)
+        _InterlockedCompareExchange((volatile long*) value,
+                                    (long) desired, (long) *expected);
+    if (previous == *expected)
+        return GLFW_TRUE;
+
+    *expected = previous;
+    return GLFW_FALSE;
+}
+
+#else
+
+static unsigned int atomicLoad(unsigned int* value)
+{
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static void atomicStore(unsigned int* value, unsigned int desired)
+{
+    __atomic_store_n(value, desired, __ATOMIC_RELEASE);
+}
+
+static unsigned int atomicExchange(unsigned int* value, unsigned int desired)
+{
+    return __atomic_exchange_n(value, desired, __ATOMIC_SEQ_CST);
+}
+
+static GLFWbool atomicCompareExchange(unsigned int* value,
+                                      unsigned int* expected,
+                                      unsigned int desired)
+{
+    return __atomic_compare_exchange_n(value, expected, desired, GLFW_FALSE,
+                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+
+#endif
+
+// Adds a user event to the queue, or returns GLFW_FALSE if it is full
+// This may be called from any thread
+//
+static GLFWbool enqueueUserEvent(_GLFWwindow* window, uint64_t data)
+{
+    _GLFWuserevent* slot;
+    unsigned int position = atomicLoad(&_glfw.userEvents.enqueue);
+
+    for (;;)
+    {
+        int difference;
+
+        slot = _glfw.userEvents.slots +
+            (position & (_GLFW_USER_EVENT_CAPACITY - 1));
+        difference = (int) (atomicLoad(&slot->sequence) - position);
+
+        if (difference == 0)
+        {
+            if (atomicCompareExchange(&_glfw.userEvents.enqueue,
+                                      &position, position + 1))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+            return GLFW_FALSE;
+        else
+            position = atomicLoad(&_glfw.userEvents.enqueue);
+    }
+
+    slot->window = window;
+    slot->serial = window->serial;
+    slot->data = data;
+    atomicStore(&slot->sequence, position + 1);
+    return GLFW_TRUE;
+}
+
+// Passes the queued user events on to their windows
+// At most one full queue is delivered per call, so that a callback that posts
+// new events cannot keep this from returning
+//
+static void dispatchUserEvents(void)
+{
+    unsigned int count;
+    _GLFWwindow* target;
+
+    atomicExchange(&_glfw.userEvents.wakeup, GLFW_FALSE);
+
+    for (count = 0;  count < _GLFW_USER_EVENT_CAPACITY;  count++)
+    {
+        _GLFWwindow* window;
+        uint64_t data;
+        unsigned int serial;
+        const unsigned int position = _glfw.userEvents.dequeue;
+        _GLFWuserevent* slot = _glfw.userEvents.slots +
+            (position & (_GLFW_USER_EVENT_CAPACITY - 1));
+
+        if (atomicLoad(&slot->sequence) != position + 1)
+            break;
+
+        window = slot->window;
+        serial = slot->serial;
+        data = slot->data;
+
+        atomicStore(&slot->sequence, position + _GLFW_USER_EVENT_CAPACITY);
+        _glfw.userEvents.dequeue = position + 1;
+
+        // Events posted to windows that have since been destroyed are dropped
+        for (target = _glfw.windowListHead;  target;  target = target->next)
+        {
+            if (target == window && target->serial == serial)
+                break;
+        }
+
+        if (target && target->callbacks.user)
+            target->callbacks.user((GLFWwindow*) target, data);
+    }
+}
+
+// Waits for events with the specified timeout, or lets the virtual clock
+// advance by it
+//
+static void waitEventsTimeout(double timeout)
+{
+    if (_glfw.hints.init.virtualClock)
+    {
+        // Complete the wait immediately by letting the virtual time pass
+        const double ticks = timeout * _glfwGetTimerFrequency();
+        if (ticks < 18446744073709551615.0)
+            _glfwAdvanceTimer((uint64_t) ticks);
+        else
+            _glfwAdvanceTimer(UINT64_MAX - _glfw.timer.virtualValue);
+
+        _glfwPlatformPollEvents();
+        return;
+    }
+
+    if (timeout == 0.0)
+        _glfwPlatformPollEvents();
+    else
+        _glfwPlatformWaitEventsTimeout(timeout);
+}
+
+// Delivers any user events and replayed events that are due and marks the end
+// of the event processing call in the input trace
+//
+static void finishEventProcessing(void)
+{
+    dispatchUserEvents();
+
+    if (_glfw.replayer)
+        _glfwReplayEvents();
+
+    if (_glfw.recorder)
+        _glfwRecordSync();
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
@@ -42,6 +222,9 @@
 //
 void _glfwInputWindowFocus(_GLFWwindow* window, GLFWbool focused)
 {
+    if (_glfw.recorder)
+        _glfwRecordEvent(_GLFW_RECORD_WINDOW_FOCUS, window, focused, 0, 0, 0);
+
     if (window->callbacks.focus)
         window->callbacks.focus((GLFWwindow*) window, focused);
 
@@ -71,6 +254,9 @@ void _glfwInputWindowFocus(_GLFWwindow* window, GLFWbool focused)
 //
 void _glfwInputWindowPos(_GLFWwindow* window, int x, int y)
 {
+    if (_glfw.recorder)
+        _glfwRecordEvent(_GLFW_RECORD_WINDOW_POS, window, x, y, 0, 0);
+
     if (window->callbacks.pos)
         window->callbacks.pos((GLFWwindow*) window, x, y);
 }
@@ -80,6 +266,9 @@ void _glfwInputWindowPos(_GLFWwindow* window, int x, int y)
 //
 void _glfwInputWindowSize(_GLFWwindow* window, int width, int height)
 {
+    if (_glfw.recorder)
+        _glfwRecordEvent(_GLFW_RECORD_WINDOW_SIZE, window, width, height, 0, 0);
+
     if (window->callbacks.size)
         window->callbacks.size((GLFWwindow*) window, width, height);
 }
@@ -88,6 +277,9 @@ void _glfwInputWindowSize(_GLFWwindow* window, int width, int height)
 //
 void _glfwInputWindowIconify(_GLFWwindow* window, GLFWbool iconified)
 {
+    if (_glfw.recorder)
+        _glfwRecordEvent(_GLFW_RECORD_WINDOW_ICONIFY, window, iconified, 0, 0, 0);
+
     if (window->callbacks.iconify)
         window->callbacks.iconify((GLFWwindow*) window, iconified);
 }
@@ -96,6 +288,9 @@ void _glfwInputWindowIconify(_GLFWwindow* window, GLFWbool iconified)
 //
 void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized)
 {
+    if (_glfw.recorder)
+        _glfwRecordEvent(_GLFW_RECORD_WINDOW_MAXIMIZE, window, maximized, 0, 0, 0);
+
     if (window->callbacks.maximize)
         window->callbacks.maximize((GLFWwindow*) window, maximized);
 }
@@ -105,6 +300,9 @@ void _glfwInputWindowMaximize(_GLFWwindow* window, GLFWbool maximized)
 //
 void _glfwInputFramebufferSize(_GLFWwindow* window, int width, int height)
 {
+    if (_glfw.recorder)
+        _glfwRecordEvent(_GLFW_RECORD_FRAMEBUFFER_SIZE, window, width, height, 0, 0);
+
     if (window->callbacks.fbsize)
         window->callbacks.fbsize((GLFWwindow*) window, width, height);
 }
@@ -114,6 +312,9 @@ void _glfwInputFramebufferSize(_GLFWwindow* window, int width, int height)
 //
 void _glfwInputWindowContentScale(_GLFWwindow* window, float xscale, float yscale)
 {
+    if (_glfw.recorder)
+        _glfwRecordMotion(_GLFW_RECORD_CONTENT_SCALE, window, xscale, yscale);
+
     if (window->callbacks.scale)
         window->callbacks.scale((GLFWwindow*) window, xscale, yscale);
 }
@@ -122,6 +323,9 @@ void _glfwInputWindowContentScale(_GLFWwindow* window, float xscale, float yscal
 //
 void _glfwInputWindowDamage(_GLFWwindow* window)
 {
+    if (_glfw.recorder)
+        _glfwRecordEvent(_GLFW_RECORD_WINDOW_DAMAGE, window, 0, 0, 0, 0);
+
     if (window->callbacks.refresh)
         window->callbacks.refresh((GLFWwindow*) window);
 }
@@ -130,6 +334,9 @@ void _glfwInputWindowDamage(_GLFWwindow* window)
 //
 void _glfwInputWindowCloseRequest(_GLFWwindow* window)
 {
+    if (_glfw.recorder)
+        _glfwRecordEvent(_GLFW_RECORD_WINDOW_CLOSE, window, 0, 0, 0, 0);
+
     window->shouldClose = GLFW_TRUE;
 
     if (window->callbacks.close)
@@ -184,9 +391,10 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
     if (!_glfwIsValidContextConfig(&ctxconfig))
         return NULL;
 
-    window = calloc(1, sizeof(_GLFWwindow));
+    window = _glfw_calloc(1, sizeof(_GLFWwindow));
     window->next = _glfw.windowListHead;
     _glfw.windowListHead = window;
+    window->serial = ++_glfw.windowSerial;
 
     window->videoMode.width       = width;
     window->videoMode.height      = height;
@@ -211,11 +419,14 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
     window->denom       = GLFW_DONT_CARE;
 
     // Open the actual window and create its context
+    _GLFW_TRACE_BEGIN("window.create");
     if (!_glfwPlatformCreateWindow(window, &wndconfig, &ctxconfig, &fbconfig))
     {
+        _GLFW_TRACE_END("window.create");
         glfwDestroyWindow((GLFWwindow*) window);
         return NULL;
     }
+    _GLFW_TRACE_END("window.create");
 
     if (ctxconfig.client != GLFW_NO_API)
     {
@@ -235,7 +446,9 @@ GLFWAPI GLFWwindow* glfwCreateWindow(int width, int height,
     {
         if (wndconfig.visible)
         {
+            _GLFW_TRACE_BEGIN("window.show");
             _glfwPlatformShowWindow(window);
+            _GLFW_TRACE_END("window.show");
             if (wndconfig.focused)
                 _glfwPlatformFocusWindow(window);
         }
@@ -466,7 +679,7 @@ GLFWAPI void glfwDestroyWindow(GLFWwindow* handle)
         *prev = window->next;
     }
 
-    free(window);
+    _glfw_free(window);
 }
 
 GLFWAPI int glfwWindowShouldClose(GLFWwindow* handle)
@@ -670,7 +883,10 @@ GLFWAPI void glfwGetWindowFrameSize(GLFWwindow* handle,
         *bottom = 0;
 
     _GLFW_REQUIRE_INIT();
+
+    _GLFW_TRACE_BEGIN("window.frame_size");
     _glfwPlatformGetWindowFrameSize(window, left, top, right, bottom);
+    _GLFW_TRACE_END("window.frame_size");
 }
 
 GLFWAPI void glfwGetWindowContentScale(GLFWwindow* handle,
@@ -757,7 +973,9 @@ GLFWAPI void glfwShowWindow(GLFWwindow* handle)
     if (window->monitor)
         return;
 
+    _GLFW_TRACE_BEGIN("window.show");
     _glfwPlatformShowWindow(window);
+    _GLFW_TRACE_END("window.show");
 
     if (window->focusOnShow)
         _glfwPlatformFocusWindow(window);
@@ -942,9 +1160,11 @@ GLFWAPI void glfwSetWindowMonitor(GLFWwindow* wh,
     window->videoMode.height      = height;
     window->videoMode.refreshRate = refreshRate;
 
+    _GLFW_TRACE_BEGIN("window.set_monitor");
     _glfwPlatformSetWindowMonitor(window, monitor,
                                   xpos, ypos, width, height,
                                   refreshRate);
+    _GLFW_TRACE_END("window.set_monitor");
 }
 
 GLFWAPI void glfwSetWindowUserPointer(GLFWwindow* handle, void* pointer)
@@ -1067,13 +1287,26 @@ GLFWAPI GLFWwindowcontentscalefun glfwSetWindowContentScaleCallback(GLFWwindow*
 GLFWAPI void glfwPollEvents(void)
 {
     _GLFW_REQUIRE_INIT();
+
+    _GLFW_TRACE_BEGIN("events.poll");
     _glfwPlatformPollEvents();
+    finishEventProcessing();
+    _GLFW_TRACE_END("events.poll");
 }
 
 GLFWAPI void glfwWaitEvents(void)
 {
     _GLFW_REQUIRE_INIT();
-    _glfwPlatformWaitEvents();
+
+    _GLFW_TRACE_BEGIN("events.wait");
+
+    if (_glfw.replayer)
+        waitEventsTimeout(_glfwGetReplayTimeout());
+    else
+        _glfwPlatformWaitEvents();
+
+    finishEventProcessing();
+    _GLFW_TRACE_END("events.wait");
 }
 
 GLFWAPI void glfwWaitEventsTimeout(double timeout)
@@ -1089,7 +1322,46 @@ GLFWAPI void glfwWaitEventsTimeout(double timeout)
         return;
     }
 
-    _glfwPlatformWaitEventsTimeout(timeout);
+    if (_glfw.replayer)
+    {
+        const double replayTimeout = _glfwGetReplayTimeout();
+        if (replayTimeout < timeout)
+            timeout = replayTimeout;
+    }
+
+    _GLFW_TRACE_BEGIN("events.wait");
+    waitEventsTimeout(timeout);
+    finishEventProcessing();
+    _GLFW_TRACE_END("events.wait");
+}
+
+GLFWAPI void glfwWaitEventsUntil(uint64_t deadline)
+{
+    _GLFW_REQUIRE_INIT();
+
+    if (_glfw.replayer)
+    {
+        const uint64_t due = _glfwGetTimerValue() +
+            (uint64_t) (_glfwGetReplayTimeout() * _glfwGetTimerFrequency());
+        if (due < deadline)
+            deadline = due;
+    }
+
+    _GLFW_TRACE_BEGIN("events.wait");
+
+    if (_glfw.hints.init.virtualClock)
+    {
+        // Complete the wait immediately by letting the virtual time pass
+        if (deadline > _glfw.timer.virtualValue)
+            _glfwAdvanceTimer(deadline - _glfw.timer.virtualValue);
+
+        _glfwPlatformPollEvents();
+    }
+    else
+        _glfwPlatformWaitEventsUntil(deadline);
+
+    finishEventProcessing();
+    _GLFW_TRACE_END("events.wait");
 }
 
 GLFWAPI void glfwPostEmptyEvent(void)
@@ -1097,3 +1369,31 @@ GLFWAPI void glfwPostEmptyEvent(void)
     _GLFW_REQUIRE_INIT();
     _glfwPlatformPostEmptyEvent();
 }
+
+GLFWAPI int glfwPostUserEvent(GLFWwindow* handle, uint64_t data)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(GLFW_FALSE);
+
+    if (!enqueueUserEvent(window, data))
+        return GLFW_FALSE;
+
+    // Only the first event since the queue was last drained needs a wakeup
+    if (!atomicExchange(&_glfw.userEvents.wakeup, GLFW_TRUE))
+        _glfwPlatformPostEmptyEvent();
+
+    return GLFW_TRUE;
+}
+
+GLFWAPI GLFWusereventfun glfwSetUserEventCallback(GLFWwindow* handle,
+                                                  GLFWusereventfun cbfun)
+{
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+
+    _GLFW_REQUIRE_INIT_OR_RETURN(NULL);
+    _GLFW_SWAP_POINTERS(window->callbacks.user, cbfun);
+    return cbfun;
+}
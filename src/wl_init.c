@@ -358,6 +358,41 @@ static const struct wl_pointer_listener pointerListener = {
     pointerHandleAxis,
 };
 
+// Caches the names of the printable keys of the specified keymap
+// The names are looked up in a fresh state, so that they are not affected by
+// the modifiers currently held
+//
+static void updateKeyNames(struct xkb_keymap* keymap)
+{
+    int scancode;
+    struct xkb_state* state;
+
+    memset(_glfw.wl.keynames, 0, sizeof(_glfw.wl.keynames));
+
+    state = xkb_state_new(keymap);
+    if (!state)
+        return;
+
+    for (scancode = 0;  scancode < 256;  scancode++)
+    {
+        const xkb_keysym_t* keysyms;
+
+        // XKB key codes are offset by 8 from evdev scancodes
+        if (xkb_state_key_get_syms(state, scancode + 8, &keysyms) == 1)
+        {
+            const long ch = _glfwKeySym2Unicode(keysyms[0]);
+            if (ch != -1)
+            {
+                const size_t count = _glfwEncodeUTF8(_glfw.wl.keynames[scancode],
+                                                     (unsigned int) ch);
+                _glfw.wl.keynames[scancode][count] = '\0';
+            }
+        }
+    }
+
+    xkb_state_unref(state);
+}
+
 static void keyboardHandleKeymap(void* data,
                                  struct wl_keyboard* keyboard,
                                  uint32_t format,
@@ -446,6 +481,8 @@ static void keyboardHandleKeymap(void* data,
     _glfw.wl.xkb.keymap = keymap;
     _glfw.wl.xkb.state = state;
 
+    updateKeyNames(keymap);
+
     _glfw.wl.xkb.controlMask =
         1 << xkb_keymap_mod_get_index(_glfw.wl.xkb.keymap, "Control");
     _glfw.wl.xkb.altMask =
@@ -1148,17 +1185,16 @@ int _glfwPlatformInit(void)
     }
 
     // Sync so we got all registry objects
+    _GLFW_TRACE_BEGIN("wl.roundtrip");
+    _GLFW_COUNT(_GLFW_COUNTER_WL_ROUNDTRIP, 1);
     wl_display_roundtrip(_glfw.wl.display);
+    _GLFW_TRACE_END("wl.roundtrip");
 
     // Sync so we got all initial output events
+    _GLFW_TRACE_BEGIN("wl.roundtrip");
+    _GLFW_COUNT(_GLFW_COUNTER_WL_ROUNDTRIP, 1);
     wl_display_roundtrip(_glfw.wl.display);
-
-#ifdef __linux__
-    if (!_glfwInitJoysticksLinux())
-        return GLFW_FALSE;
-#endif
-
-    _glfwInitTimerPOSIX();
+    _GLFW_TRACE_END("wl.roundtrip");
 
     _glfw.wl.timerfd = -1;
     if (_glfw.wl.seatVersion >= 4)
@@ -1198,7 +1234,7 @@ int _glfwPlatformInit(void)
             wl_data_device_manager_get_data_device(_glfw.wl.dataDeviceManager,
                                                    _glfw.wl.seat);
         wl_data_device_add_listener(_glfw.wl.dataDevice, &dataDeviceListener, NULL);
-        _glfw.wl.clipboardString = malloc(4096);
+        _glfw.wl.clipboardString = _glfw_calloc(4096, 1);
         if (!_glfw.wl.clipboardString)
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -1213,9 +1249,6 @@ int _glfwPlatformInit(void)
 
 void _glfwPlatformTerminate(void)
 {
-#ifdef __linux__
-    _glfwTerminateJoysticksLinux();
-#endif
     _glfwTerminateEGL();
     if (_glfw.wl.egl.handle)
     {
@@ -1299,9 +1332,9 @@ void _glfwPlatformTerminate(void)
         close(_glfw.wl.cursorTimerfd);
 
     if (_glfw.wl.clipboardString)
-        free(_glfw.wl.clipboardString);
+        _glfw_free(_glfw.wl.clipboardString);
     if (_glfw.wl.clipboardSendString)
-        free(_glfw.wl.clipboardSendString);
+        _glfw_free(_glfw.wl.clipboardSendString);
 }
 
 const char* _glfwPlatformGetVersionString(void)
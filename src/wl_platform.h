@@ -263,6 +263,8 @@ typedef struct _GLFWlibraryWayland
     int                         timerfd;
     short int                   keycodes[256];
     short int                   scancodes[GLFW_KEY_LAST + 1];
+    // UTF-8 names of the printable keys of the current keymap
+    char                        keynames[256][5];
 
     struct {
         void*                   handle;
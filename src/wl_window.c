@@ -168,12 +168,12 @@ static int createAnonymousFile(off_t size)
             return -1;
         }
 
-        name = calloc(strlen(path) + sizeof(template), 1);
+        name = _glfw_calloc(strlen(path) + sizeof(template), 1);
         strcpy(name, path);
         strcat(name, template);
 
         fd = createTmpfileCloexec(name);
-        free(name);
+        _glfw_free(name);
         if (fd < 0)
             return -1;
     }
@@ -200,7 +200,7 @@ static struct wl_buffer* createShmBuffer(const GLFWimage* image)
     int stride = image->width * 4;
     int length = image->width * image->height * 4;
     void* data;
-    int fd, i;
+    int fd;
 
     fd = createAnonymousFile(length);
     if (fd < 0)
@@ -223,17 +223,16 @@ static struct wl_buffer* createShmBuffer(const GLFWimage* image)
     pool = wl_shm_create_pool(_glfw.wl.shm, fd, length);
 
     close(fd);
-    unsigned char* source = (unsigned char*) image->pixels;
-    unsigned char* target = data;
-    for (i = 0;  i < image->width * image->height;  i++, source += 4)
-    {
-        unsigned int alpha = source[3];
+    _glfwPremultiplyPixelsARGB(data, image->pixels,
+                               image->width * image->height);
 
-        *target++ = (unsigned char) ((source[2] * alpha) / 255);
-        *target++ = (unsigned char) ((source[1] * alpha) / 255);
-        *target++ = (unsigned char) ((source[0] * alpha) / 255);
-        *target++ = (unsigned char) alpha;
-    }
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    // The wl_shm formats are little-endian
+    int i;
+    uint32_t* target = data;
+    for (i = 0;  i < image->width * image->height;  i++)
+        target[i] = __builtin_bswap32(target[i]);
+#endif
 
     buffer =
         wl_shm_pool_create_buffer(pool, 0,
@@ -438,7 +437,7 @@ static void surfaceHandleEnter(void *data,
     {
         ++window->wl.monitorsSize;
         window->wl.monitors =
-            realloc(window->wl.monitors,
+            _glfw_realloc(window->wl.monitors,
                     window->wl.monitorsSize * sizeof(_GLFWmonitor*));
     }
 
@@ -754,7 +753,11 @@ static GLFWbool createXdgSurface(_GLFWwindow* window)
     }
 
     wl_surface_commit(window->wl.surface);
+
+    _GLFW_TRACE_BEGIN("wl.roundtrip");
+    _GLFW_COUNT(_GLFW_COUNTER_WL_ROUNDTRIP, 1);
     wl_display_roundtrip(_glfw.wl.display);
+    _GLFW_TRACE_END("wl.roundtrip");
 
     return GLFW_TRUE;
 }
@@ -821,7 +824,9 @@ static void incrementCursorImage(_GLFWwindow* window)
     }
 }
 
-static void handleEvents(int timeout)
+// Waits for and handles events, for at most the specified time if any
+//
+static void handleEvents(const struct timespec* timeout)
 {
     struct wl_display* display = _glfw.wl.display;
     struct pollfd fds[] = {
@@ -850,7 +855,9 @@ static void handleEvents(int timeout)
         return;
     }
 
-    if (poll(fds, 3, timeout) > 0)
+    _GLFW_COUNT(_GLFW_COUNTER_POLL, 1);
+
+    if (ppoll(fds, 3, timeout, NULL) > 0)
     {
         if (fds[0].revents & POLLIN)
         {
@@ -972,7 +979,7 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
 
     window->wl.currentCursor = NULL;
 
-    window->wl.monitors = calloc(1, sizeof(_GLFWmonitor*));
+    window->wl.monitors = _glfw_calloc(1, sizeof(_GLFWmonitor*));
     window->wl.monitorsCount = 0;
     window->wl.monitorsSize = 1;
 
@@ -1020,14 +1027,14 @@ void _glfwPlatformDestroyWindow(_GLFWwindow* window)
     if (window->wl.surface)
         wl_surface_destroy(window->wl.surface);
 
-    free(window->wl.title);
-    free(window->wl.monitors);
+    _glfw_free(window->wl.title);
+    _glfw_free(window->wl.monitors);
 }
 
 void _glfwPlatformSetWindowTitle(_GLFWwindow* window, const char* title)
 {
     if (window->wl.title)
-        free(window->wl.title);
+        _glfw_free(window->wl.title);
     window->wl.title = _glfw_strdup(title);
     if (window->wl.xdg.toplevel)
         xdg_toplevel_set_title(window->wl.xdg.toplevel, title);
@@ -1330,17 +1337,36 @@ GLFWbool _glfwPlatformRawMouseMotionSupported(void)
 
 void _glfwPlatformPollEvents(void)
 {
-    handleEvents(0);
+    const struct timespec timeout = { 0, 0 };
+    handleEvents(&timeout);
 }
 
 void _glfwPlatformWaitEvents(void)
 {
-    handleEvents(-1);
+    handleEvents(NULL);
 }
 
 void _glfwPlatformWaitEventsTimeout(double timeout)
 {
-    handleEvents((int) (timeout * 1e3));
+    struct timespec ts;
+
+    // Timeouts this long are indistinguishable from waiting indefinitely
+    if (timeout > 1e9)
+    {
+        handleEvents(NULL);
+        return;
+    }
+
+    ts.tv_sec = (time_t) timeout;
+    ts.tv_nsec = (long) ((timeout - ts.tv_sec) * 1e9);
+    handleEvents(&ts);
+}
+
+void _glfwPlatformWaitEventsUntil(uint64_t deadline)
+{
+    struct timespec remaining = { 0, 0 };
+    _glfwGetRemainingTimePOSIX(deadline, &remaining);
+    handleEvents(&remaining);
 }
 
 void _glfwPlatformPostEmptyEvent(void)
@@ -1376,8 +1402,10 @@ void _glfwPlatformSetCursorMode(_GLFWwindow* window, int mode)
 
 const char* _glfwPlatformGetScancodeName(int scancode)
 {
-    // TODO
-    return NULL;
+    if (scancode < 0 || scancode > 255 || !_glfw.wl.keynames[scancode][0])
+        return NULL;
+
+    return _glfw.wl.keynames[scancode];
 }
 
 int _glfwPlatformGetKeyScancode(int key)
@@ -1696,11 +1724,11 @@ void _glfwPlatformSetClipboardString(const char* string)
 
     if (_glfw.wl.clipboardSendString)
     {
-        free(_glfw.wl.clipboardSendString);
+        _glfw_free(_glfw.wl.clipboardSendString);
         _glfw.wl.clipboardSendString = NULL;
     }
 
-    _glfw.wl.clipboardSendString = strdup(string);
+    _glfw.wl.clipboardSendString = _glfw_strdup(string);
     if (!_glfw.wl.clipboardSendString)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -1714,7 +1742,7 @@ void _glfwPlatformSetClipboardString(const char* string)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
                         "Wayland: Impossible to create clipboard source");
-        free(_glfw.wl.clipboardSendString);
+        _glfw_free(_glfw.wl.clipboardSendString);
         return;
     }
     wl_data_source_add_listener(_glfw.wl.dataSource,
@@ -1730,7 +1758,7 @@ static GLFWbool growClipboardString(void)
 {
     char* clipboard = _glfw.wl.clipboardString;
 
-    clipboard = realloc(clipboard, _glfw.wl.clipboardSize * 2);
+    clipboard = _glfw_realloc(clipboard, _glfw.wl.clipboardSize * 2);
     if (!clipboard)
     {
         _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -1768,7 +1796,7 @@ const char* _glfwPlatformGetClipboardString(void)
     close(fds[1]);
 
     // XXX: this is a huge hack, this function shouldn’t be synchronous!
-    handleEvents(-1);
+    handleEvents(NULL);
 
     while (1)
     {
@@ -1825,7 +1853,7 @@ int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
     PFN_vkGetPhysicalDeviceWaylandPresentationSupportKHR
         vkGetPhysicalDeviceWaylandPresentationSupportKHR =
         (PFN_vkGetPhysicalDeviceWaylandPresentationSupportKHR)
-        vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceWaylandPresentationSupportKHR");
+        _glfwGetInstanceProcAddr(instance, "vkGetPhysicalDeviceWaylandPresentationSupportKHR");
     if (!vkGetPhysicalDeviceWaylandPresentationSupportKHR)
     {
         _glfwInputError(GLFW_API_UNAVAILABLE,
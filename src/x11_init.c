@@ -226,103 +226,100 @@ static int translateKeyCode(int scancode)
     return GLFW_KEY_UNKNOWN;
 }
 
-// Create key code translation tables
+// XKB key names of printable keys and their GLFW keys for the US layout
+// This is a perfect hash table over the key names packed into 32 bits, see
+// translateKeyName
 //
-static void createKeyTables(void)
+static const struct
 {
-    int scancode, key;
-
-    memset(_glfw.x11.keycodes, -1, sizeof(_glfw.x11.keycodes));
-    memset(_glfw.x11.scancodes, -1, sizeof(_glfw.x11.scancodes));
-
-    if (_glfw.x11.xkb.available)
-    {
-        // Use XKB to determine physical key locations independently of the
-        // current keyboard layout
-
-        char name[XkbKeyNameLength + 1];
-        XkbDescPtr desc = XkbGetMap(_glfw.x11.display, 0, XkbUseCoreKbd);
-        XkbGetNames(_glfw.x11.display, XkbKeyNamesMask, desc);
-
-        // Find the X11 key code -> GLFW key code mapping
-        for (scancode = desc->min_key_code;  scancode <= desc->max_key_code;  scancode++)
-        {
-            memcpy(name, desc->names->keys[scancode].name, XkbKeyNameLength);
-            name[XkbKeyNameLength] = '\0';
-
-            // Map the key name to a GLFW key code. Note: We only map printable
-            // keys here, and we use the US keyboard layout. The rest of the
-            // keys (function keys) are mapped using traditional KeySym
-            // translations.
-            if (strcmp(name, "TLDE") == 0) key = GLFW_KEY_GRAVE_ACCENT;
-            else if (strcmp(name, "AE01") == 0) key = GLFW_KEY_1;
-            else if (strcmp(name, "AE02") == 0) key = GLFW_KEY_2;
-            else if (strcmp(name, "AE03") == 0) key = GLFW_KEY_3;
-            else if (strcmp(name, "AE04") == 0) key = GLFW_KEY_4;
-            else if (strcmp(name, "AE05") == 0) key = GLFW_KEY_5;
-            else if (strcmp(name, "AE06") == 0) key = GLFW_KEY_6;
-            else if (strcmp(name, "AE07") == 0) key = GLFW_KEY_7;
-            else if (strcmp(name, "AE08") == 0) key = GLFW_KEY_8;
-            else if (strcmp(name, "AE09") == 0) key = GLFW_KEY_9;
-            else if (strcmp(name, "AE10") == 0) key = GLFW_KEY_0;
-            else if (strcmp(name, "AE11") == 0) key = GLFW_KEY_MINUS;
-            else if (strcmp(name, "AE12") == 0) key = GLFW_KEY_EQUAL;
-            else if (strcmp(name, "AD01") == 0) key = GLFW_KEY_Q;
-            else if (strcmp(name, "AD02") == 0) key = GLFW_KEY_W;
-            else if (strcmp(name, "AD03") == 0) key = GLFW_KEY_E;
-            else if (strcmp(name, "AD04") == 0) key = GLFW_KEY_R;
-            else if (strcmp(name, "AD05") == 0) key = GLFW_KEY_T;
-            else if (strcmp(name, "AD06") == 0) key = GLFW_KEY_Y;
-            else if (strcmp(name, "AD07") == 0) key = GLFW_KEY_U;
-            else if (strcmp(name, "AD08") == 0) key = GLFW_KEY_I;
-            else if (strcmp(name, "AD09") == 0) key = GLFW_KEY_O;
-            else if (strcmp(name, "AD10") == 0) key = GLFW_KEY_P;
-            else if (strcmp(name, "AD11") == 0) key = GLFW_KEY_LEFT_BRACKET;
-            else if (strcmp(name, "AD12") == 0) key = GLFW_KEY_RIGHT_BRACKET;
-            else if (strcmp(name, "AC01") == 0) key = GLFW_KEY_A;
-            else if (strcmp(name, "AC02") == 0) key = GLFW_KEY_S;
-            else if (strcmp(name, "AC03") == 0) key = GLFW_KEY_D;
-            else if (strcmp(name, "AC04") == 0) key = GLFW_KEY_F;
-            else if (strcmp(name, "AC05") == 0) key = GLFW_KEY_G;
-            else if (strcmp(name, "AC06") == 0) key = GLFW_KEY_H;
-            else if (strcmp(name, "AC07") == 0) key = GLFW_KEY_J;
-            else if (strcmp(name, "AC08") == 0) key = GLFW_KEY_K;
-            else if (strcmp(name, "AC09") == 0) key = GLFW_KEY_L;
-            else if (strcmp(name, "AC10") == 0) key = GLFW_KEY_SEMICOLON;
-            else if (strcmp(name, "AC11") == 0) key = GLFW_KEY_APOSTROPHE;
-            else if (strcmp(name, "AB01") == 0) key = GLFW_KEY_Z;
-            else if (strcmp(name, "AB02") == 0) key = GLFW_KEY_X;
-            else if (strcmp(name, "AB03") == 0) key = GLFW_KEY_C;
-            else if (strcmp(name, "AB04") == 0) key = GLFW_KEY_V;
-            else if (strcmp(name, "AB05") == 0) key = GLFW_KEY_B;
-            else if (strcmp(name, "AB06") == 0) key = GLFW_KEY_N;
-            else if (strcmp(name, "AB07") == 0) key = GLFW_KEY_M;
-            else if (strcmp(name, "AB08") == 0) key = GLFW_KEY_COMMA;
-            else if (strcmp(name, "AB09") == 0) key = GLFW_KEY_PERIOD;
-            else if (strcmp(name, "AB10") == 0) key = GLFW_KEY_SLASH;
-            else if (strcmp(name, "BKSL") == 0) key = GLFW_KEY_BACKSLASH;
-            else if (strcmp(name, "LSGT") == 0) key = GLFW_KEY_WORLD_1;
-            else key = GLFW_KEY_UNKNOWN;
-
-            if ((scancode >= 0) && (scancode < 256))
-                _glfw.x11.keycodes[scancode] = key;
-        }
-
-        XkbFreeNames(desc, XkbKeyNamesMask, True);
-        XkbFreeKeyboard(desc, 0, True);
-    }
+    char name[XkbKeyNameLength];
+    short key;
+} keyNameTable[64] =
+{
+    { "AD01", GLFW_KEY_Q },
+    { "AC03", GLFW_KEY_D },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AB05", GLFW_KEY_B },
+    { "AE07", GLFW_KEY_7 },
+    { "AE10", GLFW_KEY_0 },
+    { "AD09", GLFW_KEY_O },
+    { "AD12", GLFW_KEY_RIGHT_BRACKET },
+    { "AB02", GLFW_KEY_X },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AE04", GLFW_KEY_4 },
+    { "AD06", GLFW_KEY_Y },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AC08", GLFW_KEY_K },
+    { "AC11", GLFW_KEY_APOSTROPHE },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AE01", GLFW_KEY_1 },
+    { "AD03", GLFW_KEY_E },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AC05", GLFW_KEY_G },
+    { "AB07", GLFW_KEY_M },
+    { "AB10", GLFW_KEY_SLASH },
+    { "AE09", GLFW_KEY_9 },
+    { "AE12", GLFW_KEY_EQUAL },
+    { "AC02", GLFW_KEY_S },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AB04", GLFW_KEY_V },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AE06", GLFW_KEY_6 },
+    { "AD08", GLFW_KEY_I },
+    { "AD11", GLFW_KEY_LEFT_BRACKET },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AB01", GLFW_KEY_Z },
+    { "AE03", GLFW_KEY_3 },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AD05", GLFW_KEY_T },
+    { "AC07", GLFW_KEY_J },
+    { "AC10", GLFW_KEY_SEMICOLON },
+    { "AB09", GLFW_KEY_PERIOD },
+    { "LSGT", GLFW_KEY_WORLD_1 },
+    { "AD02", GLFW_KEY_W },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AC04", GLFW_KEY_F },
+    { "AB06", GLFW_KEY_N },
+    { "BKSL", GLFW_KEY_BACKSLASH },
+    { "AE08", GLFW_KEY_8 },
+    { "AE11", GLFW_KEY_MINUS },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AC01", GLFW_KEY_A },
+    { "AB03", GLFW_KEY_C },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AE05", GLFW_KEY_5 },
+    { "AD07", GLFW_KEY_U },
+    { "AD10", GLFW_KEY_P },
+    { "AC09", GLFW_KEY_L },
+    { "TLDE", GLFW_KEY_GRAVE_ACCENT },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AE02", GLFW_KEY_2 },
+    { "AD04", GLFW_KEY_R },
+    { "AC06", GLFW_KEY_H },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "AB08", GLFW_KEY_COMMA },
+    { "",     GLFW_KEY_UNKNOWN },
+    { "",     GLFW_KEY_UNKNOWN },
+};
+
+// Translates an XKB key name to a GLFW key code
+// Only printable keys are mapped here, using the US keyboard layout.  The rest
+// of the keys (function keys) are mapped using traditional KeySym translations
+//
+static int translateKeyName(const char* name)
+{
+    const uint32_t packed = (uint32_t) (unsigned char) name[0] |
+                            ((uint32_t) (unsigned char) name[1] << 8) |
+                            ((uint32_t) (unsigned char) name[2] << 16) |
+                            ((uint32_t) (unsigned char) name[3] << 24);
+    // The multiplier was chosen so that every key name in the table gets its
+    // own slot
+    const uint32_t index = (uint32_t) (packed * 0x3f4078a3u) >> 26;
 
-    for (scancode = 0;  scancode < 256;  scancode++)
-    {
-        // Translate the un-translated key codes using traditional X11 KeySym
-        // lookups
-        if (_glfw.x11.keycodes[scancode] < 0)
-            _glfw.x11.keycodes[scancode] = translateKeyCode(scancode);
+    if (memcmp(keyNameTable[index].name, name, XkbKeyNameLength) == 0)
+        return keyNameTable[index].key;
 
-        // Store the reverse translation for faster key name lookup
-        if (_glfw.x11.keycodes[scancode] > 0)
-            _glfw.x11.scancodes[_glfw.x11.keycodes[scancode]] = scancode;
-    }
+    return GLFW_KEY_UNKNOWN;
 }
 
 // Check whether the IM has a usable style
@@ -582,6 +579,8 @@ static GLFWbool initExtensions(void)
         XRRScreenResources* sr = XRRGetScreenResourcesCurrent(_glfw.x11.display,
                                                               _glfw.x11.root);
 
+        _GLFW_COUNT(_GLFW_COUNTER_X11_RANDR, 2);
+
         if (!sr->ncrtc || !XRRGetCrtcGammaSize(_glfw.x11.display, sr->crtcs[0]))
         {
             // This is likely an older Nvidia driver with broken gamma support
@@ -662,6 +661,13 @@ static GLFWbool initExtensions(void)
             if (supported)
                 _glfw.x11.xkb.detectable = GLFW_TRUE;
         }
+
+        // Listen for keyboard mapping changes to keep the key tables current
+        XkbSelectEvents(_glfw.x11.display, XkbUseCoreKbd,
+                        XkbNewKeyboardNotifyMask | XkbMapNotifyMask |
+                        XkbNamesNotifyMask,
+                        XkbNewKeyboardNotifyMask | XkbMapNotifyMask |
+                        XkbNamesNotifyMask);
     }
 
 #if defined(__CYGWIN__)
@@ -702,10 +708,13 @@ static GLFWbool initExtensions(void)
         }
     }
 
-    // Update the key code LUT
-    // FIXME: We should listen to XkbMapNotify events to track changes to
-    // the keyboard mapping.
-    createKeyTables();
+    // Create the key code LUTs
+    // These are updated when the keyboard mapping changes
+    {
+        const uint64_t start = _glfwBeginInitPhase();
+        _glfwUpdateKeyTablesX11(0, 255, GLFW_TRUE);
+        _glfwEndInitPhase("key tables", start);
+    }
 
     // Detect whether an EWMH-conformant window manager is running
     detectEWMH();
@@ -882,11 +891,90 @@ void _glfwInputErrorX11(int error, const char* message)
     _glfwInputError(error, "%s: %s", message, buffer);
 }
 
+// Updates the key code LUTs for the specified range of X11 key codes
+// The XKB key names are only fetched if they may have changed, as the keysyms
+// changing does not affect them
+//
+void _glfwUpdateKeyTablesX11(int first, int last, GLFWbool names)
+{
+    int scancode;
+
+    if (first < 0)
+        first = 0;
+    if (last > 255)
+        last = 255;
+
+    if (_glfw.x11.xkb.available && names)
+    {
+        // Use XKB to determine physical key locations independently of the
+        // current keyboard layout
+
+        XkbDescPtr desc = XkbGetMap(_glfw.x11.display, 0, XkbUseCoreKbd);
+        XkbGetNames(_glfw.x11.display, XkbKeyNamesMask, desc);
+
+        for (scancode = first;  scancode <= last;  scancode++)
+        {
+            _glfw.x11.xkb.keycodes[scancode] = GLFW_KEY_UNKNOWN;
+
+            if (scancode < desc->min_key_code || scancode > desc->max_key_code)
+                continue;
+
+            _glfw.x11.xkb.keycodes[scancode] =
+                translateKeyName(desc->names->keys[scancode].name);
+        }
+
+        XkbFreeNames(desc, XkbKeyNamesMask, True);
+        XkbFreeKeyboard(desc, 0, True);
+    }
+
+    for (scancode = first;  scancode <= last;  scancode++)
+    {
+        _glfw.x11.keycodes[scancode] = GLFW_KEY_UNKNOWN;
+
+        if (_glfw.x11.xkb.available)
+            _glfw.x11.keycodes[scancode] = _glfw.x11.xkb.keycodes[scancode];
+
+        // Translate the un-translated key codes using traditional X11 KeySym
+        // lookups
+        if (_glfw.x11.keycodes[scancode] < 0)
+            _glfw.x11.keycodes[scancode] = translateKeyCode(scancode);
+
+        // Cache the names of printable keys so that looking them up is cheap
+        _glfw.x11.keynames[scancode][0] = '\0';
+
+        if (_glfw.x11.xkb.available)
+        {
+            const KeySym keysym =
+                XkbKeycodeToKeysym(_glfw.x11.display, scancode, 0, 0);
+            if (keysym != NoSymbol)
+            {
+                const long ch = _glfwKeySym2Unicode(keysym);
+                if (ch != -1)
+                {
+                    const size_t count =
+                        _glfwEncodeUTF8(_glfw.x11.keynames[scancode],
+                                        (unsigned int) ch);
+                    _glfw.x11.keynames[scancode][count] = '\0';
+                }
+            }
+        }
+    }
+
+    // The reverse translation may depend on key codes outside the range and is
+    // cheap to rebuild in full
+    memset(_glfw.x11.scancodes, -1, sizeof(_glfw.x11.scancodes));
+
+    for (scancode = 0;  scancode < 256;  scancode++)
+    {
+        if (_glfw.x11.keycodes[scancode] > 0)
+            _glfw.x11.scancodes[_glfw.x11.keycodes[scancode]] = scancode;
+    }
+}
+
 // Creates a native cursor object from the specified image and hotspot
 //
 Cursor _glfwCreateCursorX11(const GLFWimage* image, int xhot, int yhot)
 {
-    int i;
     Cursor cursor;
 
     if (!_glfw.x11.xcursor.handle)
@@ -899,18 +987,8 @@ Cursor _glfwCreateCursorX11(const GLFWimage* image, int xhot, int yhot)
     native->xhot = xhot;
     native->yhot = yhot;
 
-    unsigned char* source = (unsigned char*) image->pixels;
-    XcursorPixel* target = native->pixels;
-
-    for (i = 0;  i < image->width * image->height;  i++, target++, source += 4)
-    {
-        unsigned int alpha = source[3];
-
-        *target = (alpha << 24) |
-                  ((unsigned char) ((source[0] * alpha) / 255) << 16) |
-                  ((unsigned char) ((source[1] * alpha) / 255) <<  8) |
-                  ((unsigned char) ((source[2] * alpha) / 255) <<  0);
-    }
+    _glfwPremultiplyPixelsARGB(native->pixels, image->pixels,
+                               image->width * image->height);
 
     cursor = XcursorImageLoadCursor(_glfw.x11.display, native);
     XcursorImageDestroy(native);
@@ -925,6 +1003,8 @@ Cursor _glfwCreateCursorX11(const GLFWimage* image, int xhot, int yhot)
 
 int _glfwPlatformInit(void)
 {
+    uint64_t start;
+
 #if !defined(X_HAVE_UTF8_STRING)
     // HACK: If the current locale is "C" and the Xlib UTF-8 functions are
     //       unavailable, apply the environment's locale in the hope that it's
@@ -935,6 +1015,8 @@ int _glfwPlatformInit(void)
         setlocale(LC_CTYPE, "");
 #endif
 
+    start = _glfwBeginInitPhase();
+
     XInitThreads();
     XrmInitialize();
 
@@ -962,12 +1044,19 @@ int _glfwPlatformInit(void)
 
     getSystemContentScale(&_glfw.x11.contentScaleX, &_glfw.x11.contentScaleY);
 
+    _glfwEndInitPhase("display", start);
+    start = _glfwBeginInitPhase();
+
     if (!initExtensions())
         return GLFW_FALSE;
 
+    _glfwEndInitPhase("extensions", start);
+
     _glfw.x11.helperWindowHandle = createHelperWindow();
     _glfw.x11.hiddenCursorHandle = createHiddenCursor();
 
+    start = _glfwBeginInitPhase();
+
     if (XSupportsLocale())
     {
         XSetLocaleModifiers("");
@@ -983,14 +1072,12 @@ int _glfwPlatformInit(void)
         }
     }
 
-#if defined(__linux__)
-    if (!_glfwInitJoysticksLinux())
-        return GLFW_FALSE;
-#endif
-
-    _glfwInitTimerPOSIX();
+    _glfwEndInitPhase("input method", start);
+    start = _glfwBeginInitPhase();
 
     _glfwPollMonitorsX11();
+
+    _glfwEndInitPhase("monitors", start);
     return GLFW_TRUE;
 }
 
@@ -1014,8 +1101,8 @@ void _glfwPlatformTerminate(void)
         _glfw.x11.hiddenCursorHandle = (Cursor) 0;
     }
 
-    free(_glfw.x11.primarySelectionString);
-    free(_glfw.x11.clipboardString);
+    _glfw_free(_glfw.x11.primarySelectionString);
+    _glfw_free(_glfw.x11.clipboardString);
 
     if (_glfw.x11.im)
     {
@@ -1075,10 +1162,6 @@ void _glfwPlatformTerminate(void)
     //       cleanup callbacks that get called by that function
     _glfwTerminateEGL();
     _glfwTerminateGLX();
-
-#if defined(__linux__)
-    _glfwTerminateJoysticksLinux();
-#endif
 }
 
 const char* _glfwPlatformGetVersionString(void)
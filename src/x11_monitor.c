@@ -100,6 +100,8 @@ static GLFWvidmode vidmodeFromModeInfo(const XRRModeInfo* mi,
 //
 void _glfwPollMonitorsX11(void)
 {
+    _GLFW_TRACE_BEGIN("x11.poll_monitors");
+
     if (_glfw.x11.randr.available && !_glfw.x11.randr.monitorBroken)
     {
         int i, j, disconnectedCount, screenCount = 0;
@@ -110,13 +112,15 @@ void _glfwPollMonitorsX11(void)
         RROutput primary = XRRGetOutputPrimary(_glfw.x11.display,
                                                _glfw.x11.root);
 
+        _GLFW_COUNT(_GLFW_COUNTER_X11_RANDR, 2);
+
         if (_glfw.x11.xinerama.available)
             screens = XineramaQueryScreens(_glfw.x11.display, &screenCount);
 
         disconnectedCount = _glfw.monitorCount;
         if (disconnectedCount)
         {
-            disconnected = calloc(_glfw.monitorCount, sizeof(_GLFWmonitor*));
+            disconnected = _glfw_calloc(_glfw.monitorCount, sizeof(_GLFWmonitor*));
             memcpy(disconnected,
                    _glfw.monitors,
                    _glfw.monitorCount * sizeof(_GLFWmonitor*));
@@ -129,6 +133,7 @@ void _glfwPollMonitorsX11(void)
             XRRCrtcInfo* ci;
             _GLFWmonitor* monitor;
 
+            _GLFW_COUNT(_GLFW_COUNTER_X11_RANDR, 1);
             oi = XRRGetOutputInfo(_glfw.x11.display, sr, sr->outputs[i]);
             if (oi->connection != RR_Connected || oi->crtc == None)
             {
@@ -152,6 +157,7 @@ void _glfwPollMonitorsX11(void)
                 continue;
             }
 
+            _GLFW_COUNT(_GLFW_COUNTER_X11_RANDR, 1);
             ci = XRRGetCrtcInfo(_glfw.x11.display, sr, oi->crtc);
             if (ci->rotation == RR_Rotate_90 || ci->rotation == RR_Rotate_270)
             {
@@ -202,7 +208,7 @@ void _glfwPollMonitorsX11(void)
                 _glfwInputMonitor(disconnected[i], GLFW_DISCONNECTED, 0);
         }
 
-        free(disconnected);
+        _glfw_free(disconnected);
     }
     else
     {
@@ -213,6 +219,8 @@ void _glfwPollMonitorsX11(void)
                           GLFW_CONNECTED,
                           _GLFW_INSERT_FIRST);
     }
+
+    _GLFW_TRACE_END("x11.poll_monitors");
 }
 
 // Set the current video mode for the specified monitor
@@ -234,9 +242,12 @@ void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired)
         if (_glfwCompareVideoModes(&current, best) == 0)
             return;
 
+        _GLFW_TRACE_BEGIN("x11.randr_query");
+        _GLFW_COUNT(_GLFW_COUNTER_X11_RANDR, 3);
         sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
         ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
         oi = XRRGetOutputInfo(_glfw.x11.display, sr, monitor->x11.output);
+        _GLFW_TRACE_END("x11.randr_query");
 
         for (i = 0;  i < oi->nmode;  i++)
         {
@@ -285,8 +296,11 @@ void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor)
         if (monitor->x11.oldMode == None)
             return;
 
+        _GLFW_TRACE_BEGIN("x11.randr_query");
+        _GLFW_COUNT(_GLFW_COUNTER_X11_RANDR, 2);
         sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
         ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+        _GLFW_TRACE_END("x11.randr_query");
 
         XRRSetCrtcConfig(_glfw.x11.display,
                          sr, monitor->x11.crtc,
@@ -320,8 +334,11 @@ void _glfwPlatformGetMonitorPos(_GLFWmonitor* monitor, int* xpos, int* ypos)
         XRRScreenResources* sr;
         XRRCrtcInfo* ci;
 
+        _GLFW_TRACE_BEGIN("x11.randr_query");
+        _GLFW_COUNT(_GLFW_COUNTER_X11_RANDR, 2);
         sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
         ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+        _GLFW_TRACE_END("x11.randr_query");
 
         if (xpos)
             *xpos = ci->x;
@@ -351,8 +368,11 @@ void _glfwPlatformGetMonitorWorkarea(_GLFWmonitor* monitor, int* xpos, int* ypos
         XRRScreenResources* sr;
         XRRCrtcInfo* ci;
 
+        _GLFW_TRACE_BEGIN("x11.randr_query");
+        _GLFW_COUNT(_GLFW_COUNTER_X11_RANDR, 2);
         sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
         ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+        _GLFW_TRACE_END("x11.randr_query");
 
         areaX = ci->x;
         areaY = ci->y;
@@ -449,11 +469,14 @@ GLFWvidmode* _glfwPlatformGetVideoModes(_GLFWmonitor* monitor, int* count)
         XRRCrtcInfo* ci;
         XRROutputInfo* oi;
 
+        _GLFW_TRACE_BEGIN("x11.randr_query");
+        _GLFW_COUNT(_GLFW_COUNTER_X11_RANDR, 3);
         sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
         ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
         oi = XRRGetOutputInfo(_glfw.x11.display, sr, monitor->x11.output);
+        _GLFW_TRACE_END("x11.randr_query");
 
-        result = calloc(oi->nmode, sizeof(GLFWvidmode));
+        result = _glfw_calloc(oi->nmode, sizeof(GLFWvidmode));
 
         for (i = 0;  i < oi->nmode;  i++)
         {
@@ -484,7 +507,7 @@ GLFWvidmode* _glfwPlatformGetVideoModes(_GLFWmonitor* monitor, int* count)
     else
     {
         *count = 1;
-        result = calloc(1, sizeof(GLFWvidmode));
+        result = _glfw_calloc(1, sizeof(GLFWvidmode));
         _glfwPlatformGetVideoMode(monitor, result);
     }
 
@@ -498,8 +521,11 @@ void _glfwPlatformGetVideoMode(_GLFWmonitor* monitor, GLFWvidmode* mode)
         XRRScreenResources* sr;
         XRRCrtcInfo* ci;
 
+        _GLFW_TRACE_BEGIN("x11.randr_query");
+        _GLFW_COUNT(_GLFW_COUNTER_X11_RANDR, 2);
         sr = XRRGetScreenResourcesCurrent(_glfw.x11.display, _glfw.x11.root);
         ci = XRRGetCrtcInfo(_glfw.x11.display, sr, monitor->x11.crtc);
+        _GLFW_TRACE_END("x11.randr_query");
 
         *mode = vidmodeFromModeInfo(getModeInfo(sr, ci->mode), ci);
 
@@ -526,6 +552,8 @@ GLFWbool _glfwPlatformGetGammaRamp(_GLFWmonitor* monitor, GLFWgammaramp* ramp)
         XRRCrtcGamma* gamma = XRRGetCrtcGamma(_glfw.x11.display,
                                               monitor->x11.crtc);
 
+        _GLFW_COUNT(_GLFW_COUNTER_X11_RANDR, 2);
+
         _glfwAllocGammaArrays(ramp, size);
 
         memcpy(ramp->red,   gamma->red,   size * sizeof(unsigned short));
@@ -559,6 +587,8 @@ void _glfwPlatformSetGammaRamp(_GLFWmonitor* monitor, const GLFWgammaramp* ramp)
 {
     if (_glfw.x11.randr.available && !_glfw.x11.randr.gammaBroken)
     {
+        _GLFW_COUNT(_GLFW_COUNTER_X11_RANDR, 1);
+
         if (XRRGetCrtcGammaSize(_glfw.x11.display, monitor->x11.crtc) != ramp->size)
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -186,6 +186,15 @@ typedef struct _GLFWwindowX11
     GLFWbool        iconified;
     GLFWbool        maximized;
 
+    // Whether the window has been mapped without waiting for it to be visible
+    GLFWbool        mapPending;
+    // Whether the monitor is to be acquired when the window becomes visible
+    GLFWbool        acquirePending;
+    // Whether the window is to be focused when it becomes visible
+    GLFWbool        focusPending;
+    // Whether _NET_FRAME_EXTENTS has been requested without waiting
+    GLFWbool        frameExtentsRequested;
+
     // Whether the visual supports framebuffer transparency
     GLFWbool        transparent;
 
@@ -227,8 +236,8 @@ typedef struct _GLFWlibraryX11
     char*           primarySelectionString;
     // Clipboard string (while the selection is owned)
     char*           clipboardString;
-    // Key name string
-    char            keyName[5];
+    // UTF-8 names of the printable keys of the current layout
+    char            keynames[256][5];
     // X11 keycode to GLFW key LUT
     short int       keycodes[256];
     // GLFW key to X11 keycode LUT
@@ -328,6 +337,8 @@ typedef struct _GLFWlibraryX11
         int         errorBase;
         int         major;
         int         minor;
+        // X11 keycode to GLFW key LUT built from the XKB key names
+        short int   keycodes[256];
     } xkb;
 
     struct {
@@ -364,6 +375,8 @@ typedef struct _GLFWlibraryX11
     struct {
         void*       handle;
         PFN_XGetXCBConnection GetXCBConnection;
+        // Retrieved on first use
+        xcb_connection_t* connection;
     } x11xcb;
 
     struct {
@@ -430,6 +443,7 @@ void _glfwPollMonitorsX11(void);
 void _glfwSetVideoModeX11(_GLFWmonitor* monitor, const GLFWvidmode* desired);
 void _glfwRestoreVideoModeX11(_GLFWmonitor* monitor);
 
+void _glfwUpdateKeyTablesX11(int first, int last, GLFWbool names);
 Cursor _glfwCreateCursorX11(const GLFWimage* image, int xhot, int yhot);
 
 unsigned long _glfwGetWindowPropertyX11(Window window,
@@ -25,12 +25,17 @@
 //
 //========================================================================
 
+#if defined(__linux__)
+ // Needed for ppoll
+ #define _GNU_SOURCE
+#endif
+
 #include "internal.h"
 
 #include <X11/cursorfont.h>
 #include <X11/Xmd.h>
 
-#include <sys/select.h>
+#include <poll.h>
 
 #include <string.h>
 #include <stdio.h>
@@ -50,53 +55,93 @@
 
 #define _GLFW_XDND_VERSION 5
 
+// Number of paths per batch passed to the streaming drop callback
+#define _GLFW_DROP_BATCH_SIZE 256
+
 
-// Wait for data to arrive using select
+// Wait for data to arrive using poll, until the specified timer value if any
 // This avoids blocking other threads via the per-display Xlib lock that also
 // covers GLX functions
 //
-static GLFWbool waitForEvent(double* timeout)
+static GLFWbool waitForEventUntil(const uint64_t* deadline)
 {
-    fd_set fds;
-    const int fd = ConnectionNumber(_glfw.x11.display);
-    int count = fd + 1;
+    struct pollfd fds[2];
+    nfds_t count = 1;
+
+    fds[0].fd = ConnectionNumber(_glfw.x11.display);
+    fds[0].events = POLLIN;
 
 #if defined(__linux__)
-    if (_glfw.linjs.inotify > fd)
-        count = _glfw.linjs.inotify + 1;
-#endif
-    for (;;)
+    if (_glfw.linjs.inotify > 0)
     {
-        FD_ZERO(&fds);
-        FD_SET(fd, &fds);
-#if defined(__linux__)
-        if (_glfw.linjs.inotify > 0)
-            FD_SET(_glfw.linjs.inotify, &fds);
+        fds[1].fd = _glfw.linjs.inotify;
+        fds[1].events = POLLIN;
+        count = 2;
+    }
 #endif
 
-        if (timeout)
+    for (;;)
+    {
+        if (deadline)
         {
-            const long seconds = (long) *timeout;
-            const long microseconds = (long) ((*timeout - seconds) * 1e6);
-            struct timeval tv = { seconds, microseconds };
-            const uint64_t base = _glfwPlatformGetTimerValue();
+            struct timespec remaining;
+            int result;
 
-            const int result = select(count, &fds, NULL, NULL, &tv);
-            const int error = errno;
+            if (!_glfwGetRemainingTimePOSIX(*deadline, &remaining))
+                return GLFW_FALSE;
 
-            *timeout -= (_glfwPlatformGetTimerValue() - base) /
-                (double) _glfwPlatformGetTimerFrequency();
+            _GLFW_COUNT(_GLFW_COUNTER_POLL, 1);
 
+#if defined(__linux__)
+            result = ppoll(fds, count, &remaining, NULL);
+#else
+            // Round up so as not to wake up before the deadline
+            result = poll(fds, count,
+                          (int) (remaining.tv_sec * 1000 +
+                                 (remaining.tv_nsec + 999999) / 1000000));
+#endif
             if (result > 0)
                 return GLFW_TRUE;
-            if ((result == -1 && error == EINTR) || *timeout <= 0.0)
+            if (result == -1 && errno == EINTR)
                 return GLFW_FALSE;
         }
-        else if (select(count, &fds, NULL, NULL, NULL) != -1 || errno != EINTR)
-            return GLFW_TRUE;
+        else
+        {
+            _GLFW_COUNT(_GLFW_COUNTER_POLL, 1);
+
+            if (poll(fds, count, -1) != -1 || errno != EINTR)
+                return GLFW_TRUE;
+        }
     }
 }
 
+// Wait for data to arrive using poll, for at most the specified time if any
+// The time spent waiting is subtracted from the timeout
+//
+static GLFWbool waitForEvent(double* timeout)
+{
+    uint64_t base, deadline;
+    double ticks;
+    GLFWbool result;
+
+    if (!timeout)
+        return waitForEventUntil(NULL);
+
+    base = _glfwPlatformGetTimerValue();
+    ticks = *timeout * _glfwPlatformGetTimerFrequency();
+    if (ticks < 9223372036854775807.0)
+        deadline = base + (uint64_t) ticks;
+    else
+        deadline = UINT64_MAX;
+
+    result = waitForEventUntil(&deadline);
+
+    *timeout -= (_glfwPlatformGetTimerValue() - base) /
+        (double) _glfwPlatformGetTimerFrequency();
+
+    return result;
+}
+
 // Waits until a VisibilityNotify event arrives for the specified window or the
 // timeout period elapses (ICCCM section 4.2.2)
 //
@@ -104,6 +149,9 @@ static GLFWbool waitForVisibilityNotify(_GLFWwindow* window)
 {
     XEvent dummy;
     double timeout = 0.1;
+    GLFWbool result = GLFW_TRUE;
+
+    _GLFW_TRACE_BEGIN("x11.wait_visibility");
 
     while (!XCheckTypedWindowEvent(_glfw.x11.display,
                                    window->x11.handle,
@@ -111,10 +159,14 @@ static GLFWbool waitForVisibilityNotify(_GLFWwindow* window)
                                    &dummy))
     {
         if (!waitForEvent(&timeout))
-            return GLFW_FALSE;
+        {
+            result = GLFW_FALSE;
+            break;
+        }
     }
 
-    return GLFW_TRUE;
+    _GLFW_TRACE_END("x11.wait_visibility");
+    return result;
 }
 
 // Returns whether the window is iconified
@@ -375,112 +427,134 @@ static void updateWindowMode(_GLFWwindow* window)
     }
 }
 
-// Splits and translates a text/uri-list into separate file paths
+// Returns the value of the specified hexadecimal digit, or -1
+//
+static int hexDigitValue(char c)
+{
+    if (c >= '0' && c <= '9')
+        return c - '0';
+    if (c >= 'a' && c <= 'f')
+        return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F')
+        return c - 'A' + 10;
+
+    return -1;
+}
+
+// Translates the next entry of a text/uri-list into a file path in place
+// Returns NULL once the end of the list has been reached
 // NOTE: This function destroys the provided string
 //
-static char** parseUriList(char* text, int* count)
+static char* nextUriListPath(char** text)
 {
     const char* prefix = "file://";
-    char** paths = NULL;
-    char* line;
+    const size_t prefixLength = strlen(prefix);
 
-    *count = 0;
-
-    while ((line = strtok(text, "\r\n")))
+    for (;;)
     {
-        text = NULL;
+        char* line = *text;
+
+        while (*line == '\r' || *line == '\n')
+            line++;
+
+        if (*line == '\0')
+        {
+            *text = line;
+            return NULL;
+        }
+
+        char* end = line + strcspn(line, "\r\n");
+        *text = *end ? end + 1 : end;
+        *end = '\0';
 
         if (line[0] == '#')
             continue;
 
-        if (strncmp(line, prefix, strlen(prefix)) == 0)
+        if (strncmp(line, prefix, prefixLength) == 0)
         {
-            line += strlen(prefix);
+            line += prefixLength;
             // TODO: Validate hostname
-            while (*line != '/')
+            while (*line && *line != '/')
                 line++;
-        }
 
-        (*count)++;
+            if (*line == '\0')
+                continue;
+        }
 
-        char* path = calloc(strlen(line) + 1, 1);
-        paths = realloc(paths, *count * sizeof(char*));
-        paths[*count - 1] = path;
+        // Percent-decoding never lengthens the string, so decode in place
+        char* path = line;
+        char* target = line;
 
         while (*line)
         {
-            if (line[0] == '%' && line[1] && line[2])
+            const int high = line[0] == '%' ? hexDigitValue(line[1]) : -1;
+            const int low = high != -1 ? hexDigitValue(line[2]) : -1;
+
+            if (low != -1)
             {
-                const char digits[3] = { line[1], line[2], '\0' };
-                *path = strtol(digits, NULL, 16);
-                line += 2;
+                *target++ = (char) ((high << 4) | low);
+                line += 3;
             }
             else
-                *path = *line;
-
-            path++;
-            line++;
+                *target++ = *line++;
         }
-    }
 
-    return paths;
+        *target = '\0';
+        return path;
+    }
 }
 
-// Encode a Unicode code point to a UTF-8 stream
-// Based on cutef8 by Jeff Bezanson (Public Domain)
+// Splits and translates a text/uri-list and reports the resulting file paths
+// The paths are decoded in place and streamed in batches where possible
+// NOTE: This function destroys the provided string
 //
-static size_t encodeUTF8(char* s, unsigned int ch)
+static void inputUriList(_GLFWwindow* window, char* text)
 {
-    size_t count = 0;
+    char* batch[_GLFW_DROP_BATCH_SIZE];
+    char** paths = batch;
+    char* path;
+    int count = 0;
 
-    if (ch < 0x80)
-        s[count++] = (char) ch;
-    else if (ch < 0x800)
-    {
-        s[count++] = (ch >> 6) | 0xc0;
-        s[count++] = (ch & 0x3f) | 0x80;
-    }
-    else if (ch < 0x10000)
+    if (window->callbacks.drop || _glfw.recorder)
     {
-        s[count++] = (ch >> 12) | 0xe0;
-        s[count++] = ((ch >> 6) & 0x3f) | 0x80;
-        s[count++] = (ch & 0x3f) | 0x80;
-    }
-    else if (ch < 0x110000)
-    {
-        s[count++] = (ch >> 18) | 0xf0;
-        s[count++] = ((ch >> 12) & 0x3f) | 0x80;
-        s[count++] = ((ch >> 6) & 0x3f) | 0x80;
-        s[count++] = (ch & 0x3f) | 0x80;
+        // The whole list is needed at once, so size the array up front
+        // Each path takes up at least one line and both CR and LF end a line,
+        // as in nextUriListPath, so this is an upper bound
+        const char* c;
+        int lines = 1;
+
+        for (c = text;  *c;  c++)
+        {
+            if (*c == '\r' || *c == '\n')
+                lines++;
+        }
+
+        paths = _glfw_calloc(lines, sizeof(char*));
+
+        while ((path = nextUriListPath(&text)))
+            paths[count++] = path;
+
+        _glfwInputDrop(window, count, (const char**) paths);
+        _glfw_free(paths);
+        return;
     }
 
-    return count;
-}
+    if (!window->callbacks.dropStream)
+        return;
 
-// Decode a Unicode code point from a UTF-8 stream
-// Based on cutef8 by Jeff Bezanson (Public Domain)
-//
-#if defined(X_HAVE_UTF8_STRING)
-static unsigned int decodeUTF8(const char** s)
-{
-    unsigned int ch = 0, count = 0;
-    static const unsigned int offsets[] =
+    while ((path = nextUriListPath(&text)))
     {
-        0x00000000u, 0x00003080u, 0x000e2080u,
-        0x03c82080u, 0xfa082080u, 0x82082080u
-    };
+        if (count == _GLFW_DROP_BATCH_SIZE)
+        {
+            _glfwInputDropStream(window, count, (const char**) paths, GLFW_FALSE);
+            count = 0;
+        }
 
-    do
-    {
-        ch = (ch << 6) + (unsigned char) **s;
-        (*s)++;
-        count++;
-    } while ((**s & 0xc0) == 0x80);
+        paths[count++] = path;
+    }
 
-    assert(count <= 6);
-    return ch - offsets[count - 1];
+    _glfwInputDropStream(window, count, (const char**) paths, GLFW_TRUE);
 }
-#endif /*X_HAVE_UTF8_STRING*/
 
 // Convert the specified Latin-1 string to UTF-8
 //
@@ -492,11 +566,11 @@ static char* convertLatin1toUTF8(const char* source)
     for (sp = source;  *sp;  sp++)
         size += (*sp & 0x80) ? 2 : 1;
 
-    char* target = calloc(size, 1);
+    char* target = _glfw_calloc(size, 1);
     char* tp = target;
 
     for (sp = source;  *sp;  sp++)
-        tp += encodeUTF8(tp, *sp);
+        tp += _glfwEncodeUTF8(tp, *sp);
 
     return target;
 }
@@ -930,12 +1004,12 @@ static void handleSelectionClear(XEvent* event)
 {
     if (event->xselectionclear.selection == _glfw.x11.PRIMARY)
     {
-        free(_glfw.x11.primarySelectionString);
+        _glfw_free(_glfw.x11.primarySelectionString);
         _glfw.x11.primarySelectionString = NULL;
     }
     else
     {
-        free(_glfw.x11.clipboardString);
+        _glfw_free(_glfw.x11.clipboardString);
         _glfw.x11.clipboardString = NULL;
     }
 }
@@ -978,7 +1052,7 @@ static const char* getSelectionString(Atom selection)
         return *selectionString;
     }
 
-    free(*selectionString);
+    _glfw_free(*selectionString);
     *selectionString = NULL;
 
     for (i = 0;  i < targetCount;  i++)
@@ -996,6 +1070,8 @@ static const char* getSelectionString(Atom selection)
                           _glfw.x11.helperWindowHandle,
                           CurrentTime);
 
+        _GLFW_TRACE_BEGIN("x11.wait_selection");
+
         while (!XCheckTypedWindowEvent(_glfw.x11.display,
                                        _glfw.x11.helperWindowHandle,
                                        SelectionNotify,
@@ -1004,6 +1080,8 @@ static const char* getSelectionString(Atom selection)
             waitForEvent(NULL);
         }
 
+        _GLFW_TRACE_END("x11.wait_selection");
+
         if (notification.xselection.property == None)
             continue;
 
@@ -1012,6 +1090,7 @@ static const char* getSelectionString(Atom selection)
                       isSelPropNewValueNotify,
                       (XPointer) &notification);
 
+        _GLFW_COUNT(_GLFW_COUNTER_X11_GET_WINDOW_PROPERTY, 1);
         XGetWindowProperty(_glfw.x11.display,
                            notification.xselection.requestor,
                            notification.xselection.property,
@@ -1032,6 +1111,8 @@ static const char* getSelectionString(Atom selection)
 
             for (;;)
             {
+                _GLFW_TRACE_BEGIN("x11.wait_selection");
+
                 while (!XCheckIfEvent(_glfw.x11.display,
                                       &dummy,
                                       isSelPropNewValueNotify,
@@ -1040,7 +1121,10 @@ static const char* getSelectionString(Atom selection)
                     waitForEvent(NULL);
                 }
 
+                _GLFW_TRACE_END("x11.wait_selection");
+
                 XFree(data);
+                _GLFW_COUNT(_GLFW_COUNTER_X11_GET_WINDOW_PROPERTY, 1);
                 XGetWindowProperty(_glfw.x11.display,
                                    notification.xselection.requestor,
                                    notification.xselection.property,
@@ -1057,7 +1141,7 @@ static const char* getSelectionString(Atom selection)
                 if (itemCount)
                 {
                     size += itemCount;
-                    string = realloc(string, size);
+                    string = _glfw_realloc(string, size);
                     string[size - itemCount - 1] = '\0';
                     strcat(string, data);
                 }
@@ -1067,7 +1151,7 @@ static const char* getSelectionString(Atom selection)
                     if (targets[i] == XA_STRING)
                     {
                         *selectionString = convertLatin1toUTF8(string);
-                        free(string);
+                        _glfw_free(string);
                     }
                     else
                         *selectionString = string;
@@ -1186,6 +1270,57 @@ static void processEvent(XEvent *event)
         }
     }
 
+    if (_glfw.x11.xkb.available)
+    {
+        if (event->type == _glfw.x11.xkb.eventBase + XkbEventCode)
+        {
+            XkbEvent* xkb = (XkbEvent*) event;
+
+            // Only the key codes whose mapping changed are translated again
+            // The key names are only fetched again if they have changed
+            if (xkb->any.xkb_type == XkbNewKeyboardNotify)
+                _glfwUpdateKeyTablesX11(0, 255, GLFW_TRUE);
+            else if (xkb->any.xkb_type == XkbMapNotify)
+            {
+                XkbRefreshKeyboardMapping(&xkb->map);
+
+                if (xkb->map.changed & XkbKeySymsMask)
+                {
+                    _glfwUpdateKeyTablesX11(xkb->map.first_key_sym,
+                                            xkb->map.first_key_sym +
+                                            xkb->map.num_key_syms - 1,
+                                            GLFW_FALSE);
+                }
+            }
+            else if (xkb->any.xkb_type == XkbNamesNotify)
+            {
+                if (xkb->names.changed & XkbKeyNamesMask)
+                {
+                    _glfwUpdateKeyTablesX11(xkb->names.first_key,
+                                            xkb->names.first_key +
+                                            xkb->names.num_keys - 1,
+                                            GLFW_TRUE);
+                }
+            }
+
+            return;
+        }
+    }
+    else if (event->type == MappingNotify)
+    {
+        XRefreshKeyboardMapping(&event->xmapping);
+
+        if (event->xmapping.request == MappingKeyboard)
+        {
+            _glfwUpdateKeyTablesX11(event->xmapping.first_keycode,
+                                    event->xmapping.first_keycode +
+                                    event->xmapping.count - 1,
+                                    GLFW_FALSE);
+        }
+
+        return;
+    }
+
     if (event->type == GenericEvent)
     {
         if (_glfw.x11.xi.available)
@@ -1281,7 +1416,7 @@ static void processEvent(XEvent *event)
 
                     if (status == XBufferOverflow)
                     {
-                        chars = calloc(count + 1, 1);
+                        chars = _glfw_calloc(count + 1, 1);
                         count = Xutf8LookupString(window->x11.ic,
                                                   &event->xkey,
                                                   chars, count,
@@ -1290,10 +1425,8 @@ static void processEvent(XEvent *event)
 
                     if (status == XLookupChars || status == XLookupBoth)
                     {
-                        const char* c = chars;
                         chars[count] = '\0';
-                        while (c - chars < count)
-                            _glfwInputChar(window, decodeUTF8(&c), mods, plain);
+                        _glfwInputText(window, chars, count, mods, plain);
                     }
 #else /*X_HAVE_UTF8_STRING*/
                     wchar_t buffer[16];
@@ -1308,7 +1441,7 @@ static void processEvent(XEvent *event)
 
                     if (status == XBufferOverflow)
                     {
-                        chars = calloc(count, sizeof(wchar_t));
+                        chars = _glfw_calloc(count, sizeof(wchar_t));
                         count = XwcLookupString(window->x11.ic,
                                                 &event->xkey,
                                                 chars, count,
@@ -1324,7 +1457,7 @@ static void processEvent(XEvent *event)
 #endif /*X_HAVE_UTF8_STRING*/
 
                     if (chars != buffer)
-                        free(chars);
+                        _glfw_free(chars);
                 }
             }
             else
@@ -1673,6 +1806,7 @@ static void processEvent(XEvent *event)
                 if (_glfw.x11.xdnd.version > _GLFW_XDND_VERSION)
                     return;
 
+                _GLFW_COUNT(_GLFW_COUNTER_X11_TRANSLATE_COORDINATES, 1);
                 XTranslateCoordinates(_glfw.x11.display,
                                       _glfw.x11.root,
                                       window->x11.handle,
@@ -1722,16 +1856,7 @@ static void processEvent(XEvent *event)
                                               (unsigned char**) &data);
 
                 if (result)
-                {
-                    int i, count;
-                    char** paths = parseUriList(data, &count);
-
-                    _glfwInputDrop(window, count, (const char**) paths);
-
-                    for (i = 0;  i < count;  i++)
-                        free(paths[i]);
-                    free(paths);
-                }
+                    inputUriList(window, data);
 
                 if (data)
                     XFree(data);
@@ -1801,6 +1926,32 @@ static void processEvent(XEvent *event)
             return;
         }
 
+        case VisibilityNotify:
+        {
+            // The window was shown asynchronously and can now be made full
+            // screen and focused, see GLFW_X11_ASYNC_WINDOWS
+            window->x11.mapPending = GLFW_FALSE;
+
+            if (window->x11.acquirePending)
+            {
+                window->x11.acquirePending = GLFW_FALSE;
+
+                if (window->monitor)
+                {
+                    updateWindowMode(window);
+                    acquireMonitor(window);
+                }
+            }
+
+            if (window->x11.focusPending)
+            {
+                window->x11.focusPending = GLFW_FALSE;
+                _glfwPlatformFocusWindow(window);
+            }
+
+            return;
+        }
+
         case Expose:
         {
             _glfwInputWindowDamage(window);
@@ -1851,6 +2002,16 @@ static void processEvent(XEvent *event)
     }
 }
 
+// Returns the XCB connection of the display, retrieving it on first use
+//
+static xcb_connection_t* getXCBConnection(void)
+{
+    if (!_glfw.x11.x11xcb.connection)
+        _glfw.x11.x11xcb.connection = XGetXCBConnection(_glfw.x11.display);
+
+    return _glfw.x11.x11xcb.connection;
+}
+
 
 //////////////////////////////////////////////////////////////////////////
 //////                       GLFW internal API                      //////
@@ -1868,6 +2029,8 @@ unsigned long _glfwGetWindowPropertyX11(Window window,
     int actualFormat;
     unsigned long itemCount, bytesAfter;
 
+    _GLFW_TRACE_BEGIN("x11.XGetWindowProperty");
+    _GLFW_COUNT(_GLFW_COUNTER_X11_GET_WINDOW_PROPERTY, 1);
     XGetWindowProperty(_glfw.x11.display,
                        window,
                        property,
@@ -1880,6 +2043,7 @@ unsigned long _glfwGetWindowPropertyX11(Window window,
                        &itemCount,
                        &bytesAfter,
                        value);
+    _GLFW_TRACE_END("x11.XGetWindowProperty");
 
     return itemCount;
 }
@@ -2009,8 +2173,14 @@ int _glfwPlatformCreateWindow(_GLFWwindow* window,
     if (window->monitor)
     {
         _glfwPlatformShowWindow(window);
-        updateWindowMode(window);
-        acquireMonitor(window);
+
+        if (_glfw.hints.init.x11.asyncWindows)
+            window->x11.acquirePending = GLFW_TRUE;
+        else
+        {
+            updateWindowMode(window);
+            acquireMonitor(window);
+        }
     }
 
     XFlush(_glfw.x11.display);
@@ -2087,12 +2257,12 @@ void _glfwPlatformSetWindowIcon(_GLFWwindow* window,
 {
     if (count)
     {
-        int i, j, longCount = 0;
+        int i, longCount = 0;
 
         for (i = 0;  i < count;  i++)
             longCount += 2 + images[i].width * images[i].height;
 
-        long* icon = calloc(longCount, sizeof(long));
+        long* icon = _glfw_calloc(longCount, sizeof(long));
         long* target = icon;
 
         for (i = 0;  i < count;  i++)
@@ -2100,13 +2270,9 @@ void _glfwPlatformSetWindowIcon(_GLFWwindow* window,
             *target++ = images[i].width;
             *target++ = images[i].height;
 
-            for (j = 0;  j < images[i].width * images[i].height;  j++)
-            {
-                *target++ = (images[i].pixels[j * 4 + 0] << 16) |
-                            (images[i].pixels[j * 4 + 1] <<  8) |
-                            (images[i].pixels[j * 4 + 2] <<  0) |
-                            (images[i].pixels[j * 4 + 3] << 24);
-            }
+            _glfwWidenPixelsARGB(target, images[i].pixels,
+                                 images[i].width * images[i].height);
+            target += images[i].width * images[i].height;
         }
 
         XChangeProperty(_glfw.x11.display, window->x11.handle,
@@ -2116,7 +2282,7 @@ void _glfwPlatformSetWindowIcon(_GLFWwindow* window,
                         (unsigned char*) icon,
                         longCount);
 
-        free(icon);
+        _glfw_free(icon);
     }
     else
     {
@@ -2132,8 +2298,11 @@ void _glfwPlatformGetWindowPos(_GLFWwindow* window, int* xpos, int* ypos)
     Window dummy;
     int x, y;
 
+    _GLFW_TRACE_BEGIN("x11.XTranslateCoordinates");
+    _GLFW_COUNT(_GLFW_COUNTER_X11_TRANSLATE_COORDINATES, 1);
     XTranslateCoordinates(_glfw.x11.display, window->x11.handle, _glfw.x11.root,
                           0, 0, &x, &y, &dummy);
+    _GLFW_TRACE_END("x11.XTranslateCoordinates");
 
     if (xpos)
         *xpos = x;
@@ -2168,7 +2337,11 @@ void _glfwPlatformSetWindowPos(_GLFWwindow* window, int xpos, int ypos)
 void _glfwPlatformGetWindowSize(_GLFWwindow* window, int* width, int* height)
 {
     XWindowAttributes attribs;
+
+    _GLFW_TRACE_BEGIN("x11.XGetWindowAttributes");
+    _GLFW_COUNT(_GLFW_COUNTER_X11_GET_WINDOW_ATTRIBUTES, 1);
     XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &attribs);
+    _GLFW_TRACE_END("x11.XGetWindowAttributes");
 
     if (width)
         *width = attribs.width;
@@ -2229,8 +2402,22 @@ void _glfwPlatformGetWindowFrameSize(_GLFWwindow* window,
     if (_glfw.x11.NET_FRAME_EXTENTS == None)
         return;
 
-    if (!_glfwPlatformWindowVisible(window) &&
-        _glfw.x11.NET_REQUEST_FRAME_EXTENTS)
+    const GLFWbool request = !_glfwPlatformWindowVisible(window) &&
+                             _glfw.x11.NET_REQUEST_FRAME_EXTENTS;
+
+    if (request && _glfw.hints.init.x11.asyncWindows)
+    {
+        // Request _NET_FRAME_EXTENTS without waiting for the reply
+        // The frame size is reported as zero until the window manager sets it
+        if (!window->x11.frameExtentsRequested)
+        {
+            sendEventToWM(window, _glfw.x11.NET_REQUEST_FRAME_EXTENTS,
+                          0, 0, 0, 0, 0);
+            XFlush(_glfw.x11.display);
+            window->x11.frameExtentsRequested = GLFW_TRUE;
+        }
+    }
+    else if (request)
     {
         XEvent event;
         double timeout = 0.5;
@@ -2245,6 +2432,8 @@ void _glfwPlatformGetWindowFrameSize(_GLFWwindow* window,
         //       They have been fixed but broken versions are still in the wild
         //       If you are affected by this and your window manager is NOT
         //       listed above, PLEASE report it to their and our issue trackers
+        _GLFW_TRACE_BEGIN("x11.wait_frame_extents");
+
         while (!XCheckIfEvent(_glfw.x11.display,
                               &event,
                               isFrameExtentsEvent,
@@ -2252,11 +2441,14 @@ void _glfwPlatformGetWindowFrameSize(_GLFWwindow* window,
         {
             if (!waitForEvent(&timeout))
             {
+                _GLFW_TRACE_END("x11.wait_frame_extents");
                 _glfwInputError(GLFW_PLATFORM_ERROR,
                                 "X11: The window manager has a broken _NET_REQUEST_FRAME_EXTENTS implementation; please report this issue");
                 return;
             }
         }
+
+        _GLFW_TRACE_END("x11.wait_frame_extents");
     }
 
     if (_glfwGetWindowPropertyX11(window->x11.handle,
@@ -2316,7 +2508,11 @@ void _glfwPlatformRestoreWindow(_GLFWwindow* window)
     if (_glfwPlatformWindowIconified(window))
     {
         XMapWindow(_glfw.x11.display, window->x11.handle);
-        waitForVisibilityNotify(window);
+
+        if (_glfw.hints.init.x11.asyncWindows)
+            window->x11.mapPending = GLFW_TRUE;
+        else
+            waitForVisibilityNotify(window);
     }
     else if (_glfwPlatformWindowVisible(window))
     {
@@ -2358,11 +2554,29 @@ void _glfwPlatformShowWindow(_GLFWwindow* window)
         return;
 
     XMapWindow(_glfw.x11.display, window->x11.handle);
-    waitForVisibilityNotify(window);
+
+    if (_glfw.hints.init.x11.asyncWindows)
+    {
+        // A full screen window whose pending acquisition was cancelled by
+        // hiding it acquires its monitor when it becomes visible again
+        if (window->monitor && window->monitor->window != window)
+            window->x11.acquirePending = GLFW_TRUE;
+
+        window->x11.mapPending = GLFW_TRUE;
+        XFlush(_glfw.x11.display);
+    }
+    else
+        waitForVisibilityNotify(window);
 }
 
 void _glfwPlatformHideWindow(_GLFWwindow* window)
 {
+    // Cancel everything waiting for the window to become visible, so that an
+    // already queued VisibilityNotify does not act on the hidden window
+    window->x11.mapPending = GLFW_FALSE;
+    window->x11.acquirePending = GLFW_FALSE;
+    window->x11.focusPending = GLFW_FALSE;
+
     XUnmapWindow(_glfw.x11.display, window->x11.handle);
     XFlush(_glfw.x11.display);
 }
@@ -2378,6 +2592,14 @@ void _glfwPlatformRequestWindowAttention(_GLFWwindow* window)
 
 void _glfwPlatformFocusWindow(_GLFWwindow* window)
 {
+    // Focusing a window that is not yet viewable causes a BadMatch error, so
+    // wait until it has become visible
+    if (window->x11.mapPending)
+    {
+        window->x11.focusPending = GLFW_TRUE;
+        return;
+    }
+
     if (_glfw.x11.NET_ACTIVE_WINDOW)
         sendEventToWM(window, _glfw.x11.NET_ACTIVE_WINDOW, 1, 0, 0, 0, 0);
     else
@@ -2419,6 +2641,8 @@ void _glfwPlatformSetWindowMonitor(_GLFWwindow* window,
     if (window->monitor)
         releaseMonitor(window);
 
+    window->x11.acquirePending = GLFW_FALSE;
+
     _glfwInputWindowMonitor(window, monitor);
     updateNormalHints(window, width, height);
 
@@ -2427,6 +2651,16 @@ void _glfwPlatformSetWindowMonitor(_GLFWwindow* window,
         if (!_glfwPlatformWindowVisible(window))
         {
             XMapRaised(_glfw.x11.display, window->x11.handle);
+
+            if (_glfw.hints.init.x11.asyncWindows)
+            {
+                // The window mode is set when the window becomes visible
+                window->x11.mapPending = GLFW_TRUE;
+                window->x11.acquirePending = GLFW_TRUE;
+                XFlush(_glfw.x11.display);
+                return;
+            }
+
             waitForVisibilityNotify(window);
         }
 
@@ -2448,7 +2682,11 @@ int _glfwPlatformWindowFocused(_GLFWwindow* window)
     Window focused;
     int state;
 
+    _GLFW_TRACE_BEGIN("x11.XGetInputFocus");
+    _GLFW_COUNT(_GLFW_COUNTER_X11_GET_INPUT_FOCUS, 1);
     XGetInputFocus(_glfw.x11.display, &focused, &state);
+    _GLFW_TRACE_END("x11.XGetInputFocus");
+
     return window->x11.handle == focused;
 }
 
@@ -2460,7 +2698,12 @@ int _glfwPlatformWindowIconified(_GLFWwindow* window)
 int _glfwPlatformWindowVisible(_GLFWwindow* window)
 {
     XWindowAttributes wa;
+
+    _GLFW_TRACE_BEGIN("x11.XGetWindowAttributes");
+    _GLFW_COUNT(_GLFW_COUNTER_X11_GET_WINDOW_ATTRIBUTES, 1);
     XGetWindowAttributes(_glfw.x11.display, window->x11.handle, &wa);
+    _GLFW_TRACE_END("x11.XGetWindowAttributes");
+
     return wa.map_state == IsViewable;
 }
 
@@ -2507,12 +2750,17 @@ int _glfwPlatformWindowHovered(_GLFWwindow* window)
         Window root;
         int rootX, rootY, childX, childY;
         unsigned int mask;
+        Bool result;
 
-        if (!XQueryPointer(_glfw.x11.display, w,
-                           &root, &w, &rootX, &rootY, &childX, &childY, &mask))
-        {
+        _GLFW_TRACE_BEGIN("x11.XQueryPointer");
+        _GLFW_COUNT(_GLFW_COUNTER_X11_QUERY_POINTER, 1);
+        result = XQueryPointer(_glfw.x11.display, w,
+                               &root, &w, &rootX, &rootY, &childX, &childY,
+                               &mask);
+        _GLFW_TRACE_END("x11.XQueryPointer");
+
+        if (!result)
             return GLFW_FALSE;
-        }
 
         if (w == window->x11.handle)
             return GLFW_TRUE;
@@ -2735,6 +2983,17 @@ void _glfwPlatformWaitEventsTimeout(double timeout)
     _glfwPlatformPollEvents();
 }
 
+void _glfwPlatformWaitEventsUntil(uint64_t deadline)
+{
+    while (!XPending(_glfw.x11.display))
+    {
+        if (!waitForEventUntil(&deadline))
+            break;
+    }
+
+    _glfwPlatformPollEvents();
+}
+
 void _glfwPlatformPostEmptyEvent(void)
 {
     XEvent event;
@@ -2755,10 +3014,13 @@ void _glfwPlatformGetCursorPos(_GLFWwindow* window, double* xpos, double* ypos)
     int rootX, rootY, childX, childY;
     unsigned int mask;
 
+    _GLFW_TRACE_BEGIN("x11.XQueryPointer");
+    _GLFW_COUNT(_GLFW_COUNTER_X11_QUERY_POINTER, 1);
     XQueryPointer(_glfw.x11.display, window->x11.handle,
                   &root, &child,
                   &rootX, &rootY, &childX, &childY,
                   &mask);
+    _GLFW_TRACE_END("x11.XQueryPointer");
 
     if (xpos)
         *xpos = childX;
@@ -2797,20 +3059,10 @@ const char* _glfwPlatformGetScancodeName(int scancode)
     if (!_glfw.x11.xkb.available)
         return NULL;
 
-    const KeySym keysym = XkbKeycodeToKeysym(_glfw.x11.display, scancode, 0, 0);
-    if (keysym == NoSymbol)
-        return NULL;
-
-    const long ch = _glfwKeySym2Unicode(keysym);
-    if (ch == -1)
-        return NULL;
-
-    const size_t count = encodeUTF8(_glfw.x11.keyName, (unsigned int) ch);
-    if (count == 0)
+    if (scancode < 0 || scancode > 255 || !_glfw.x11.keynames[scancode][0])
         return NULL;
 
-    _glfw.x11.keyName[count] = '\0';
-    return _glfw.x11.keyName;
+    return _glfw.x11.keynames[scancode];
 }
 
 int _glfwPlatformGetKeyScancode(int key)
@@ -2876,7 +3128,7 @@ void _glfwPlatformSetCursor(_GLFWwindow* window, _GLFWcursor* cursor)
 
 void _glfwPlatformSetClipboardString(const char* string)
 {
-    free(_glfw.x11.clipboardString);
+    _glfw_free(_glfw.x11.clipboardString);
     _glfw.x11.clipboardString = _glfw_strdup(string);
 
     XSetSelectionOwner(_glfw.x11.display,
@@ -2930,7 +3182,7 @@ int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
         PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR
             vkGetPhysicalDeviceXcbPresentationSupportKHR =
             (PFN_vkGetPhysicalDeviceXcbPresentationSupportKHR)
-            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceXcbPresentationSupportKHR");
+            _glfwGetInstanceProcAddr(instance, "vkGetPhysicalDeviceXcbPresentationSupportKHR");
         if (!vkGetPhysicalDeviceXcbPresentationSupportKHR)
         {
             _glfwInputError(GLFW_API_UNAVAILABLE,
@@ -2938,7 +3190,7 @@ int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
             return GLFW_FALSE;
         }
 
-        xcb_connection_t* connection = XGetXCBConnection(_glfw.x11.display);
+        xcb_connection_t* connection = getXCBConnection();
         if (!connection)
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -2956,7 +3208,7 @@ int _glfwPlatformGetPhysicalDevicePresentationSupport(VkInstance instance,
         PFN_vkGetPhysicalDeviceXlibPresentationSupportKHR
             vkGetPhysicalDeviceXlibPresentationSupportKHR =
             (PFN_vkGetPhysicalDeviceXlibPresentationSupportKHR)
-            vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceXlibPresentationSupportKHR");
+            _glfwGetInstanceProcAddr(instance, "vkGetPhysicalDeviceXlibPresentationSupportKHR");
         if (!vkGetPhysicalDeviceXlibPresentationSupportKHR)
         {
             _glfwInputError(GLFW_API_UNAVAILABLE,
@@ -2982,7 +3234,7 @@ VkResult _glfwPlatformCreateWindowSurface(VkInstance instance,
         VkXcbSurfaceCreateInfoKHR sci;
         PFN_vkCreateXcbSurfaceKHR vkCreateXcbSurfaceKHR;
 
-        xcb_connection_t* connection = XGetXCBConnection(_glfw.x11.display);
+        xcb_connection_t* connection = getXCBConnection();
         if (!connection)
         {
             _glfwInputError(GLFW_PLATFORM_ERROR,
@@ -3068,7 +3320,7 @@ GLFWAPI void glfwSetX11SelectionString(const char* string)
 {
     _GLFW_REQUIRE_INIT();
 
-    free(_glfw.x11.primarySelectionString);
+    _glfw_free(_glfw.x11.primarySelectionString);
     _glfw.x11.primarySelectionString = _glfw_strdup(string);
 
     XSetSelectionOwner(_glfw.x11.display,
@@ -0,0 +1,141 @@
+//========================================================================
+// Icon and cursor conversion benchmark
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test measures the time taken to set a large multi-resolution window
+// icon and to create large custom cursors, which is dominated by pixel format
+// conversion on most platforms
+//
+//========================================================================
+
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static const int sizes[] = { 16, 24, 32, 48, 64, 96, 128, 256, 512 };
+#define SIZE_COUNT (sizeof(sizes) / sizeof(sizes[0]))
+
+static void usage(void)
+{
+    printf("Usage: iconbench [-h] [-n RUNS]\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, run, runs = 100, pixelCount = 0;
+    double start, icon, cursor;
+    GLFWimage images[SIZE_COUNT];
+    GLFWwindow* window;
+
+    while ((ch = getopt(argc, argv, "hn:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                runs = atoi(optarg);
+                if (runs < 1)
+                {
+                    usage();
+                    exit(EXIT_FAILURE);
+                }
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
+
+    window = glfwCreateWindow(640, 480, "Icon Benchmark", NULL, NULL);
+    if (!window)
+    {
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0;  i < (int) SIZE_COUNT;  i++)
+    {
+        int j;
+
+        images[i].width = sizes[i];
+        images[i].height = sizes[i];
+        images[i].pixels = malloc(sizes[i] * sizes[i] * 4);
+
+        for (j = 0;  j < sizes[i] * sizes[i] * 4;  j++)
+            images[i].pixels[j] = (unsigned char) rand();
+
+        pixelCount += sizes[i] * sizes[i];
+    }
+
+    start = glfwGetTime();
+
+    for (run = 0;  run < runs;  run++)
+        glfwSetWindowIcon(window, SIZE_COUNT, images);
+
+    icon = (glfwGetTime() - start) / runs;
+
+    start = glfwGetTime();
+
+    for (run = 0;  run < runs;  run++)
+    {
+        for (i = 0;  i < (int) SIZE_COUNT;  i++)
+        {
+            GLFWcursor* handle = glfwCreateCursor(images + i, 0, 0);
+            if (handle)
+                glfwDestroyCursor(handle);
+        }
+    }
+
+    cursor = (glfwGetTime() - start) / runs;
+
+    printf("%-12s %12s %12s\n", "Operation", "Mean (ms)", "ns/pixel");
+    printf("%-12s %12.4f %12.4f\n", "icon", icon * 1000.0, icon * 1e9 / pixelCount);
+    printf("%-12s %12.4f %12.4f\n", "cursor", cursor * 1000.0, cursor * 1e9 / pixelCount);
+
+    for (i = 0;  i < (int) SIZE_COUNT;  i++)
+        free(images[i].pixels);
+
+    glfwTerminate();
+    exit(EXIT_SUCCESS);
+}
@@ -26,10 +26,21 @@
 // This test renders a marker at the cursor position reported by GLFW to
 // check how much it lags behind the hardware mouse cursor
 //
+// On the null platform it also has a scripted mode, where a secondary thread
+// injects pointer and key events and the main thread reads back each frame it
+// presents to find the first frame showing the response.  The latency from
+// injection to that readback is reported for each event loop mode and swap
+// interval.
+//
 //========================================================================
 
+#include "tinycthread.h"
+
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
+#if defined(GLFW_EXPOSE_NATIVE_NULL)
+ #include <GLFW/glfw3native.h>
+#endif
 
 #define NK_IMPLEMENTATION
 #define NK_INCLUDE_FIXED_TYPES
@@ -51,10 +62,12 @@
 
 void usage(void)
 {
-    printf("Usage: inputlag [-h] [-f]\n");
+    printf("Usage: inputlag [-h] [-f] [-s] [-n SAMPLES]\n");
     printf("Options:\n");
     printf("  -f create full screen window\n");
     printf("  -h show this help\n");
+    printf("  -n number of samples per configuration in scripted mode (default 100)\n");
+    printf("  -s run scripted latency measurement (null platform only)\n");
 }
 
 struct nk_vec2 cursor_new, cursor_pos, cursor_vel;
@@ -148,9 +161,259 @@ void draw_marker(struct nk_command_buffer* canvas, int lead, struct nk_vec2 pos)
     nk_fill_circle(canvas, rect, colors[lead]);
 }
 
+#if defined(GLFW_EXPOSE_NATIVE_NULL)
+
+enum { sample_pointer, sample_key, sample_kind_count };
+enum { loop_poll, loop_wait, loop_wait_timeout, loop_mode_count };
+
+static const char* sample_kind_names[] = { "pointer", "key" };
+static const char* loop_mode_names[] = { "poll", "wait", "wait-timeout" };
+
+#define MARKER_SIZE 16
+
+// State shared with the injector thread, protected by injector_lock.  The
+// expected marker position and color persist across configurations.
+static mtx_t injector_lock;
+static cnd_t injector_cond;
+static int injector_running;
+static int injector_samples;
+static int sample_pending;
+static int sample_kind;
+static int sample_x, sample_y = 240;
+static int sample_green;
+static uint64_t sample_stamp;
+
+// The marker color, toggled by the injected key presses
+static int marker_green = nk_false;
+
+static void scripted_key_callback(GLFWwindow* window, int key, int scancode, int action, int mods)
+{
+    if (key == GLFW_KEY_C && action == GLFW_PRESS)
+        marker_green = !marker_green;
+}
+
+// Injects one event at a time, each at a random point of the frame, and waits
+// until its response has been seen before injecting the next
+static int injector_main(void* data)
+{
+    int i;
+    unsigned int seed = 1;
+    GLFWwindow* window = data;
+
+    for (i = 0;  i < injector_samples;  i++)
+    {
+        struct timespec time;
+
+        seed = seed * 1103515245 + 12345;
+
+        clock_gettime(CLOCK_REALTIME, &time);
+        time.tv_nsec += (long) ((seed >> 8) % 20000000);
+        if (time.tv_nsec >= 1000000000)
+        {
+            time.tv_sec += 1;
+            time.tv_nsec -= 1000000000;
+        }
+
+        thrd_sleep(&time, NULL);
+
+        mtx_lock(&injector_lock);
+
+        if (!injector_running)
+        {
+            mtx_unlock(&injector_lock);
+            break;
+        }
+
+        // Every other sample moves the pointer between two spots and every
+        // other toggles the marker color with a key press
+        sample_kind = i % 2 ? sample_key : sample_pointer;
+        if (sample_kind == sample_pointer)
+            sample_x = sample_x == 160 ? 480 : 160;
+        else
+            sample_green = !sample_green;
+
+        sample_pending = nk_true;
+        sample_stamp = glfwGetTimerValue();
+
+        if (sample_kind == sample_pointer)
+            glfwNullInjectCursorPos(window, sample_x, sample_y);
+        else
+        {
+            glfwNullInjectKey(window, GLFW_KEY_C, -1, GLFW_PRESS, 0);
+            glfwNullInjectKey(window, GLFW_KEY_C, -1, GLFW_RELEASE, 0);
+        }
+
+        while (sample_pending && injector_running)
+            cnd_wait(&injector_cond, &injector_lock);
+
+        mtx_unlock(&injector_lock);
+    }
+
+    return 0;
+}
+
+static int compare_latencies(const void* fp, const void* sp)
+{
+    const double f = *(const double*) fp;
+    const double s = *(const double*) sp;
+    return (f > s) - (f < s);
+}
+
+static double percentile(const double* latencies, int count, double fraction)
+{
+    return latencies[(int) ((count - 1) * fraction + 0.5)];
+}
+
+// Renders frames in the specified event loop mode until all samples have been
+// seen, and prints their latency percentiles
+static void measure_latency(GLFWwindow* window, int mode, int interval, int samples)
+{
+    int i, kind, result;
+    int counts[sample_kind_count] = {0};
+    double* latencies[sample_kind_count];
+    thrd_t thread;
+
+    for (kind = 0;  kind < sample_kind_count;  kind++)
+        latencies[kind] = calloc(samples, sizeof(double));
+
+    glfwSwapInterval(interval);
+
+    injector_running = nk_true;
+    injector_samples = samples;
+    sample_pending = nk_false;
+
+    if (thrd_create(&thread, injector_main, window) != thrd_success)
+    {
+        fprintf(stderr, "Failed to create injector thread\n");
+        glfwTerminate();
+        exit(EXIT_FAILURE);
+    }
+
+    while (counts[sample_pointer] + counts[sample_key] < samples)
+    {
+        int width, height, fb_width, fb_height;
+        unsigned char rgba[4];
+
+        if (mode == loop_poll)
+            glfwPollEvents();
+        else if (mode == loop_wait)
+            glfwWaitEvents();
+        else
+            glfwWaitEventsTimeout(0.01);
+
+        if (glfwWindowShouldClose(window))
+            break;
+
+        sample_input(window);
+
+        glfwGetWindowSize(window, &width, &height);
+        glfwGetFramebufferSize(window, &fb_width, &fb_height);
+
+        glViewport(0, 0, fb_width, fb_height);
+        glDisable(GL_SCISSOR_TEST);
+        glClearColor(0.f, 0.f, 0.f, 1.f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glEnable(GL_SCISSOR_TEST);
+        glScissor((int) (cursor_pos.x * fb_width / width) - MARKER_SIZE / 2,
+                  fb_height - (int) (cursor_pos.y * fb_height / height) - MARKER_SIZE / 2,
+                  MARKER_SIZE, MARKER_SIZE);
+        if (marker_green)
+            glClearColor(0.f, 1.f, 0.f, 1.f);
+        else
+            glClearColor(1.f, 0.f, 0.f, 1.f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        glfwSwapBuffers(window);
+
+        mtx_lock(&injector_lock);
+
+        if (sample_pending)
+        {
+            // Read back the presented frame where the response should appear
+            glReadBuffer(GL_FRONT);
+            glReadPixels(sample_x * fb_width / width,
+                         fb_height - 1 - sample_y * fb_height / height,
+                         1, 1, GL_RGBA, GL_UNSIGNED_BYTE, rgba);
+
+            if (rgba[0] == (sample_green ? 0 : 255) &&
+                rgba[1] == (sample_green ? 255 : 0))
+            {
+                const double latency = (glfwGetTimerValue() - sample_stamp) /
+                                       (double) glfwGetTimerFrequency();
+
+                latencies[sample_kind][counts[sample_kind]++] = latency;
+                sample_pending = nk_false;
+                cnd_signal(&injector_cond);
+            }
+        }
+
+        mtx_unlock(&injector_lock);
+    }
+
+    mtx_lock(&injector_lock);
+    injector_running = nk_false;
+    cnd_signal(&injector_cond);
+    mtx_unlock(&injector_lock);
+
+    thrd_join(thread, &result);
+
+    for (kind = 0;  kind < sample_kind_count;  kind++)
+    {
+        const int count = counts[kind];
+        double* l = latencies[kind];
+
+        if (!count)
+            continue;
+
+        qsort(l, count, sizeof(double), compare_latencies);
+
+        printf("%-13s %8i %-8s %7i %9.3f %9.3f %9.3f %9.3f\n",
+               loop_mode_names[mode], interval, sample_kind_names[kind], count,
+               percentile(l, count, 0.5) * 1000.0,
+               percentile(l, count, 0.9) * 1000.0,
+               percentile(l, count, 0.99) * 1000.0,
+               l[count - 1] * 1000.0);
+    }
+
+    for (i = 0;  i < sample_kind_count;  i++)
+        free(latencies[i]);
+}
+
+static void run_scripted(GLFWwindow* window, int samples)
+{
+    int mode, interval;
+
+    mtx_init(&injector_lock, mtx_plain);
+    cnd_init(&injector_cond);
+
+    glfwSetKeyCallback(window, scripted_key_callback);
+    glfwSetCursorPosCallback(window, cursor_pos_callback);
+
+    printf("%-13s %8s %-8s %7s %9s %9s %9s %9s\n",
+           "Mode", "Interval", "Event", "Samples",
+           "p50 (ms)", "p90 (ms)", "p99 (ms)", "max (ms)");
+
+    for (mode = 0;  mode < loop_mode_count;  mode++)
+    {
+        for (interval = 0;  interval <= 1;  interval++)
+        {
+            measure_latency(window, mode, interval, samples);
+            if (glfwWindowShouldClose(window))
+                break;
+        }
+    }
+
+    cnd_destroy(&injector_cond);
+    mtx_destroy(&injector_lock);
+}
+
+#endif
+
 int main(int argc, char** argv)
 {
     int ch, width, height;
+    int scripted = GLFW_FALSE, samples = 100;
     unsigned long frame_count = 0;
     double last_time, current_time;
     double frame_rate = 0;
@@ -162,7 +425,7 @@ int main(int argc, char** argv)
 
     int show_forecasts = nk_true;
 
-    while ((ch = getopt(argc, argv, "fh")) != -1)
+    while ((ch = getopt(argc, argv, "fhn:s")) != -1)
     {
         switch (ch)
         {
@@ -173,9 +436,30 @@ int main(int argc, char** argv)
             case 'f':
                 fullscreen = GLFW_TRUE;
                 break;
+
+            case 'n':
+                samples = atoi(optarg);
+                if (samples < 1)
+                {
+                    usage();
+                    exit(EXIT_FAILURE);
+                }
+                break;
+
+            case 's':
+                scripted = GLFW_TRUE;
+                break;
         }
     }
 
+#if !defined(GLFW_EXPOSE_NATIVE_NULL)
+    if (scripted)
+    {
+        fprintf(stderr, "Scripted mode requires the null platform\n");
+        exit(EXIT_FAILURE);
+    }
+#endif
+
     glfwSetErrorCallback(error_callback);
 
     if (!glfwInit())
@@ -211,6 +495,16 @@ int main(int argc, char** argv)
 
     glfwMakeContextCurrent(window);
     gladLoadGLLoader((GLADloadproc) glfwGetProcAddress);
+
+#if defined(GLFW_EXPOSE_NATIVE_NULL)
+    if (scripted)
+    {
+        run_scripted(window, samples);
+        glfwTerminate();
+        exit(EXIT_SUCCESS);
+    }
+#endif
+
     update_vsync();
 
     last_time = glfwGetTime();
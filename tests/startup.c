@@ -0,0 +1,170 @@
+//========================================================================
+// Startup time test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test measures the time taken by glfwInit and glfwTerminate, and by
+// each phase of initialization as reported by glfwGetInitPhases
+//
+//========================================================================
+
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "getopt.h"
+
+#define MAX_PHASES 32
+
+typedef struct
+{
+    const char* name;
+    double total;
+    double min;
+} Phase;
+
+static void usage(void)
+{
+    printf("Usage: startup [-h] [-j] [-n RUNS]\n");
+    printf("Options:\n");
+    printf("  -j include joystick and gamepad mapping initialization\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static double get_seconds(void)
+{
+    // The GLFW timer is not available while the library is terminated
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void add_sample(Phase* phases, int* count, const char* name, double seconds)
+{
+    int i;
+
+    for (i = 0;  i < *count;  i++)
+    {
+        if (strcmp(phases[i].name, name) == 0)
+            break;
+    }
+
+    if (i == *count)
+    {
+        if (*count == MAX_PHASES)
+            return;
+
+        phases[i].name = name;
+        phases[i].total = 0.0;
+        phases[i].min = seconds;
+        (*count)++;
+    }
+
+    phases[i].total += seconds;
+    if (seconds < phases[i].min)
+        phases[i].min = seconds;
+}
+
+int main(int argc, char** argv)
+{
+    int ch, i, run, runs = 100, joysticks = GLFW_FALSE;
+    int phaseCount = 0;
+    Phase phases[MAX_PHASES];
+
+    while ((ch = getopt(argc, argv, "hjn:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'j':
+                joysticks = GLFW_TRUE;
+                break;
+
+            case 'n':
+                runs = atoi(optarg);
+                if (runs < 1)
+                {
+                    usage();
+                    exit(EXIT_FAILURE);
+                }
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    for (run = 0;  run < runs;  run++)
+    {
+        int count;
+        const GLFWinitphase* trace;
+        double start, init, terminate;
+
+        start = get_seconds();
+
+        if (!glfwInit())
+            exit(EXIT_FAILURE);
+
+        init = get_seconds() - start;
+
+        if (joysticks)
+            glfwJoystickPresent(GLFW_JOYSTICK_1);
+
+        trace = glfwGetInitPhases(&count);
+        for (i = 0;  i < count;  i++)
+            add_sample(phases, &phaseCount, trace[i].name, trace[i].duration);
+
+        start = get_seconds();
+        glfwTerminate();
+        terminate = get_seconds() - start;
+
+        add_sample(phases, &phaseCount, "glfwInit", init);
+        add_sample(phases, &phaseCount, "glfwTerminate", terminate);
+    }
+
+    printf("%-16s %12s %12s\n", "Phase", "Mean (ms)", "Min (ms)");
+
+    for (i = 0;  i < phaseCount;  i++)
+    {
+        printf("%-16s %12.4f %12.4f\n",
+               phases[i].name,
+               phases[i].total * 1000.0 / runs,
+               phases[i].min * 1000.0);
+    }
+
+    exit(EXIT_SUCCESS);
+}
+
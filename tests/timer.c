@@ -0,0 +1,120 @@
+//========================================================================
+// Timer cost test
+// Copyright (c) Camilla Löwy <elmindreda@glfw.org>
+//
+// This software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would
+//    be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such, and must not
+//    be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source
+//    distribution.
+//
+//========================================================================
+//
+// This test measures the cost per call of the timer functions, with and
+// without the GLFW_TSC_TIMER init hint
+//
+//========================================================================
+
+#include <GLFW/glfw3.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "getopt.h"
+
+static void usage(void)
+{
+    printf("Usage: timer [-h] [-n CALLS]\n");
+}
+
+static void error_callback(int error, const char* description)
+{
+    fprintf(stderr, "Error: %s\n", description);
+}
+
+static void measure(const char* label, int tsc, long calls)
+{
+    long i;
+    uint64_t start, end, frequency, sink = 0;
+    double seconds = 0.0;
+
+    glfwInitHint(GLFW_TSC_TIMER, tsc);
+
+    if (!glfwInit())
+        exit(EXIT_FAILURE);
+
+    frequency = glfwGetTimerFrequency();
+
+    start = glfwGetTimerValue();
+    for (i = 0;  i < calls;  i++)
+        sink += glfwGetTimerValue();
+    end = glfwGetTimerValue();
+
+    printf("%s timer (%.3f MHz):\n", label, frequency / 1e6);
+    printf("  glfwGetTimerValue: %.2f ns per call\n",
+           (end - start) * 1e9 / frequency / calls);
+
+    start = glfwGetTimerValue();
+    for (i = 0;  i < calls;  i++)
+        seconds += glfwGetTime();
+    end = glfwGetTimerValue();
+
+    printf("  glfwGetTime:       %.2f ns per call\n",
+           (end - start) * 1e9 / frequency / calls);
+
+    // Keep the loops from being optimized away
+    if (sink == 0 && seconds < 0.0)
+        printf("\n");
+
+    glfwTerminate();
+}
+
+int main(int argc, char** argv)
+{
+    int ch;
+    long calls = 10000000;
+
+    while ((ch = getopt(argc, argv, "hn:")) != -1)
+    {
+        switch (ch)
+        {
+            case 'h':
+                usage();
+                exit(EXIT_SUCCESS);
+
+            case 'n':
+                calls = atol(optarg);
+                if (calls < 1)
+                {
+                    usage();
+                    exit(EXIT_FAILURE);
+                }
+                break;
+
+            default:
+                usage();
+                exit(EXIT_FAILURE);
+        }
+    }
+
+    glfwSetErrorCallback(error_callback);
+
+    measure("Default", GLFW_FALSE, calls);
+    measure("TSC", GLFW_TRUE, calls);
+
+    exit(EXIT_SUCCESS);
+}
+